@@ -5,12 +5,53 @@
 #include <vector>
 #include <string>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <random>
 #include <chrono>
 #include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <cmath>
-#include <queue>
+#include <cctype>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <new>
+#include <climits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <cstddef>
+#include <cerrno>
+// Headless capture creates its OpenGL context through EGL where available, which
+// needs no display server (link with -lEGL); define VISAL_NO_EGL to build without it
+#if defined(__linux__) && !defined(VISAL_NO_EGL)
+#define CAPTURE_USE_EGL
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+#ifdef _WIN32
+#define NOMINMAX
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define _CRT_SECURE_NO_WARNINGS
 #define IMGUI_CONFIG_FLAGS_DOCKING_ENABLE (1)
@@ -18,6 +59,94 @@
 #define IMGUI_ENABLE_FREETYPE
 #define M_PI 3.14159265358979323846
 
+// Allocation Tracking
+// Every operator new is attributed to the AllocScope active on the calling
+// thread. The owner and size are kept in a header in front of the block, so a
+// delete is credited back to the same owner whichever thread frees it.
+// (ImGui allocates through its own allocator and isn't counted.)
+enum AllocTag { TagOther, TagLinkedList, TagStack, TagQueue, TagSortData, TagSorting, TagExternalSort, TagBatchScript, TagGraph, TagIngest, AllocTagCount };
+const char* allocTagNames[AllocTagCount] = { "Other", "Linked List", "Stack", "Queue", "Sort Data", "Sorting", "External Sort", "Batch Script", "Graph", "Ingest" };
+
+struct AllocStats {
+	std::atomic<long long> liveBytes{ 0 };
+	std::atomic<long long> peakBytes{ 0 };
+	std::atomic<long long> allocations{ 0 };
+	std::atomic<long long> frees{ 0 };
+};
+AllocStats allocStats[AllocTagCount];
+
+thread_local int currentAllocTag = TagOther;
+thread_local size_t threadAllocationCount = 0; // operator new calls made by this thread
+
+// Attributes allocations on this thread to tag until the scope ends
+struct AllocScope {
+	int previous;
+	AllocScope(int tag) : previous(currentAllocTag) { currentAllocTag = tag; }
+	~AllocScope() { currentAllocTag = previous; }
+};
+
+// Attributes allocations to tag unless an enclosing scope already named an owner,
+// so a container used as a benchmark's scratch isn't counted as the view's
+struct DefaultAllocScope {
+	int previous;
+	DefaultAllocScope(int tag) : previous(currentAllocTag) { if (currentAllocTag == TagOther) currentAllocTag = tag; }
+	~DefaultAllocScope() { currentAllocTag = previous; }
+};
+
+// Restarts peak tracking for tag from its current live bytes (e.g. when a sort starts)
+void resetAllocPeak(int tag) {
+	allocStats[tag].peakBytes = allocStats[tag].liveBytes.load();
+}
+
+struct alignas(std::max_align_t) AllocHeader {
+	size_t size;
+	int tag;
+};
+
+void* trackedAlloc(std::size_t size) noexcept {
+	AllocHeader* header = static_cast<AllocHeader*>(std::malloc(sizeof(AllocHeader) + size));
+	if (!header) return nullptr;
+	header->size = size;
+	header->tag = currentAllocTag;
+	threadAllocationCount++;
+
+	AllocStats& stats = allocStats[header->tag];
+	stats.allocations.fetch_add(1, std::memory_order_relaxed);
+	long long live = stats.liveBytes.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+	long long peak = stats.peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !stats.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+	return header + 1;
+}
+
+void trackedFree(void* p) noexcept {
+	if (!p) return;
+	AllocHeader* header = static_cast<AllocHeader*>(p) - 1;
+	AllocStats& stats = allocStats[header->tag];
+	stats.frees.fetch_add(1, std::memory_order_relaxed);
+	stats.liveBytes.fetch_sub((long long)header->size, std::memory_order_relaxed);
+	std::free(header);
+}
+
+void* operator new(std::size_t size) {
+	if (void* p = trackedAlloc(size)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	if (void* p = trackedAlloc(size)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
 // Linked List Classes and Functions
 // Node structure for the linked list
 struct Node {
@@ -30,23 +159,33 @@ struct Node {
 class LinkedList {
 public:
 	Node* head;
-	LinkedList() : head(nullptr) {}
+	Node* tail;   // Last node, kept so appends don't walk the list
+	size_t count; // Number of nodes
+	LinkedList() : head(nullptr), tail(nullptr), count(0) {}
+	~LinkedList() { clear(); }
+	LinkedList(const LinkedList&) = delete;
+	LinkedList& operator=(const LinkedList&) = delete;
 
 	void insertAtBeginning(int value) {
+		DefaultAllocScope scope(TagLinkedList);
 		Node* newNode = new Node(value);
 		newNode->next = head;
 		head = newNode;
+		if (!tail) tail = newNode;
+		count++;
 	}
 
 	void insertAtEnd(int value) {
+		DefaultAllocScope scope(TagLinkedList);
 		Node* newNode = new Node(value);
 		if (!head) {
-			head = newNode;
+			head = tail = newNode;
+			count++;
 			return;
 		}
-		Node* temp = head;
-		while (temp->next) temp = temp->next;
-		temp->next = newNode;
+		tail->next = newNode;
+		tail = newNode;
+		count++;
 	}
 
 	void insertAtPosition(int value, int position) {
@@ -59,9 +198,12 @@ public:
 			temp = temp->next;
 		}
 		if (!temp) return; // Position out of bounds
+		DefaultAllocScope scope(TagLinkedList);
 		Node* newNode = new Node(value);
 		newNode->next = temp->next;
 		temp->next = newNode;
+		if (temp == tail) tail = newNode;
+		count++;
 	}
 
 	void deleteAtPosition(int position) {
@@ -69,7 +211,9 @@ public:
 		if (position == 0) {
 			Node* toDelete = head;
 			head = head->next;
+			if (!head) tail = nullptr;
 			delete toDelete;
+			count--;
 			return;
 		}
 		Node* temp = head;
@@ -79,7 +223,59 @@ public:
 		if (!temp || !temp->next) return; // Position out of bounds
 		Node* toDelete = temp->next;
 		temp->next = temp->next->next;
+		if (toDelete == tail) tail = temp;
 		delete toDelete;
+		count--;
+	}
+
+	// Batch operations (used by the script runner to build large lists in bulk)
+	void insertManyAtBeginning(const int* values, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			insertAtBeginning(values[i]);
+		}
+	}
+
+	void insertManyAtEnd(const int* values, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			insertAtEnd(values[i]);
+		}
+	}
+
+	// Deletes up to n nodes starting at position, walking to it only once
+	void deleteManyAtPosition(int position, size_t n) {
+		if (n == 0 || position < 0) return;
+		Node* prev = nullptr;
+		Node* temp = head;
+		for (int i = 0; i < position && temp; i++) {
+			prev = temp;
+			temp = temp->next;
+		}
+		while (temp && n > 0) {
+			Node* toDelete = temp;
+			temp = temp->next;
+			delete toDelete;
+			count--;
+			n--;
+		}
+		if (prev) prev->next = temp;
+		else head = temp;
+		if (!temp) tail = prev;
+	}
+
+	void clear() {
+		while (head) {
+			Node* toDelete = head;
+			head = head->next;
+			delete toDelete;
+		}
+		tail = nullptr;
+		count = 0;
+	}
+
+	void swap(LinkedList& other) {
+		std::swap(head, other.head);
+		std::swap(tail, other.tail);
+		std::swap(count, other.count);
 	}
 
 	std::vector<int> toVector() {
@@ -93,6 +289,239 @@ public:
 	}
 };
 
+// Bottom-up merge sort that only relinks Node::next: O(1) extra space and no
+// allocations. Each step() merges one pair of adjacent runs, so the list view can
+// animate it merge by merge; a pass that leaves a single run ends the sort. The
+// list stays fully linked between steps (merged part, then the rest).
+class LinkedListMergeSorter {
+public:
+	LinkedListMergeSorter() : dummy(0) {}
+
+	void begin(LinkedList& target) {
+		list = &target;
+		dummy.next = list->head;
+		tail = &dummy;
+		rest = dummy.next;
+		width = 1;
+		runsThisPass = 0;
+		runStart = runEnd = nullptr;
+		sorting = list->count > 1;
+	}
+
+	bool active() const { return sorting; }
+	size_t runWidth() const { return width; }
+
+	// Most recently merged run, for highlighting
+	const Node* lastRunStart() const { return runStart; }
+	const Node* lastRunEnd() const { return runEnd; }
+
+	// Merges the next pair of runs; returns false once the list is sorted
+	bool step() {
+		if (!sorting) return false;
+		if (!rest) {
+			if (runsThisPass <= 1) {
+				finishSort();
+				return false;
+			}
+			width *= 2;
+			runsThisPass = 0;
+			tail = &dummy;
+			rest = dummy.next;
+		}
+
+		// Cut the left run and the right run off the rest
+		Node* left = rest;
+		Node* leftLast = advance(left, width - 1);
+		Node* right = leftLast->next;
+		runsThisPass++;
+		if (!right) {
+			// Lone run at the end of the pass; it is already linked in place
+			runStart = left;
+			runEnd = leftLast;
+			tail = leftLast;
+			rest = nullptr;
+			return true;
+		}
+		Node* rightLast = advance(right, width - 1);
+		Node* after = rightLast->next;
+		leftLast->next = nullptr;
+		rightLast->next = nullptr;
+
+		// Merge, taking from the left run on ties to stay stable
+		Node* mergedTail = tail;
+		while (left && right) {
+			if (right->data < left->data) {
+				mergedTail->next = right;
+				right = right->next;
+			}
+			else {
+				mergedTail->next = left;
+				left = left->next;
+			}
+			mergedTail = mergedTail->next;
+		}
+		mergedTail->next = left ? left : right;
+		while (mergedTail->next) mergedTail = mergedTail->next;
+
+		runStart = tail->next;
+		runEnd = mergedTail;
+		mergedTail->next = after;
+		tail = mergedTail;
+		rest = after;
+		list->head = dummy.next;
+		return true;
+	}
+
+	// Runs the remaining merges without animation
+	void finish() {
+		while (step()) {
+		}
+	}
+
+private:
+	// Returns the node steps after n, or the last node if the list ends first
+	static Node* advance(Node* n, size_t steps) {
+		while (steps-- > 0 && n->next) n = n->next;
+		return n;
+	}
+
+	void finishSort() {
+		list->head = dummy.next;
+		list->tail = tail;
+		runStart = runEnd = nullptr;
+		sorting = false;
+	}
+
+	LinkedList* list = nullptr;
+	Node dummy;               // Sentinel in front of the head; lives inside the sorter
+	Node* tail = nullptr;     // Last node of the merged part of this pass
+	Node* rest = nullptr;     // First node not yet merged in this pass
+	Node* runStart = nullptr;
+	Node* runEnd = nullptr;
+	size_t width = 1;
+	size_t runsThisPass = 0;
+	bool sorting = false;
+};
+LinkedListMergeSorter linkedListSorter;
+
+// Merges two null-terminated sorted chains, taking from a on ties
+Node* mergeNodeChains(Node* a, Node* b) {
+	Node head(0);
+	Node* tail = &head;
+	while (a && b) {
+		if (b->data < a->data) {
+			tail->next = b;
+			b = b->next;
+		}
+		else {
+			tail->next = a;
+			a = a->next;
+		}
+		tail = tail->next;
+	}
+	tail->next = a ? a : b;
+	return head.next;
+}
+
+// Sorts a whole list in place. Same relinking merge as the animated sorter, but
+// nodes are fed one at a time into bins of 1, 2, 4... sorted runs, so most merges
+// touch nodes that are still in cache instead of walking the list once per pass.
+void mergeSortList(LinkedList& list) {
+	Node* bins[64] = {};
+	size_t used = 0;
+	Node* n = list.head;
+	while (n) {
+		Node* run = n;
+		n = n->next;
+		run->next = nullptr;
+		size_t i = 0;
+		for (; i < used && bins[i]; ++i) {
+			run = mergeNodeChains(bins[i], run);
+			bins[i] = nullptr;
+		}
+		if (i == used) used++;
+		bins[i] = run;
+	}
+
+	Node* sorted = nullptr;
+	for (size_t i = 0; i < used; ++i) {
+		if (bins[i]) sorted = mergeNodeChains(bins[i], sorted);
+	}
+	list.head = sorted;
+	list.tail = sorted;
+	while (list.tail && list.tail->next) list.tail = list.tail->next;
+}
+
+// Times the relinking sort against copying to a vector, std::sort and writing
+// the values back, on two identical random lists built off the UI thread
+struct ListSortBenchmark {
+	std::thread worker;
+	std::atomic<bool> running{ false };
+	int nodes = 0;
+	double relinkMs = 0.0, copyMs = 0.0;
+	size_t relinkAllocations = 0, copyAllocations = 0;
+	bool sorted = false;
+	bool outOfMemory = false; // The lists didn't fit; the timings are stale
+};
+ListSortBenchmark listSortBenchmark;
+
+bool isListSorted(const LinkedList& list) {
+	for (const Node* n = list.head; n && n->next; n = n->next) {
+		if (n->next->data < n->data) return false;
+	}
+	return true;
+}
+
+void runListSortBenchmark(int nodes) {
+	LinkedList relinked, copied;
+	std::mt19937 rng(7);
+	for (int i = 0; i < nodes; ++i) {
+		int value = (int)(rng() % 1000000);
+		relinked.insertAtEnd(value);
+		copied.insertAtEnd(value);
+	}
+
+	size_t allocations = threadAllocationCount;
+	auto start = std::chrono::high_resolution_clock::now();
+	mergeSortList(relinked);
+	listSortBenchmark.relinkMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	listSortBenchmark.relinkAllocations = threadAllocationCount - allocations;
+
+	allocations = threadAllocationCount;
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<int> values = copied.toVector();
+	std::sort(values.begin(), values.end());
+	size_t i = 0;
+	for (Node* n = copied.head; n; n = n->next) n->data = values[i++];
+	listSortBenchmark.copyMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	listSortBenchmark.copyAllocations = threadAllocationCount - allocations;
+
+	listSortBenchmark.sorted = isListSorted(relinked) && isListSorted(copied) && relinked.count == copied.count;
+}
+
+void startListSortBenchmark(int nodes) {
+	if (listSortBenchmark.running) return;
+	if (listSortBenchmark.worker.joinable()) listSortBenchmark.worker.join();
+	listSortBenchmark.nodes = nodes;
+	listSortBenchmark.running = true;
+	resetAllocPeak(TagSorting);
+	listSortBenchmark.outOfMemory = false;
+	listSortBenchmark.worker = std::thread([nodes]() {
+		AllocScope scope(TagSorting);
+		try {
+			runListSortBenchmark(nodes);
+		}
+		catch (const std::bad_alloc&) {
+			listSortBenchmark.outOfMemory = true; // The lists were freed while unwinding
+		}
+		listSortBenchmark.running = false;
+		});
+}
+
+// True while a batch script runs. Its result replaces the views' structures when
+// it's collected, so they lock editing until then (defined with the batch runner)
+bool batchScriptRunning();
+
 // Draw a node (filled circle)
 void DrawCircle(float x, float y, float radius, ImU32 color, int segments = 32) {
 	ImDrawList* drawList = ImGui::GetBackgroundDrawList();
@@ -114,10 +543,72 @@ void DrawArrow(float x1, float y1, float x2, float y2, ImU32 color, float thickn
 	drawList->AddTriangleFilled(ImVec2(x2, y2), ImVec2(arrowX1, arrowY1), ImVec2(arrowX2, arrowY2), color);
 }
 
+// Integer Label Cache
+// Formatted and measured text for the values drawn in the node, stack and queue
+// views. One cache keyed by value serves all three, so elements shifting along
+// (a dequeue, an insert at the front, a stream draining the queue) reuse their
+// labels instead of being formatted again. A value hashes to a window of
+// probeLength entries and a miss replaces the least recently used one there;
+// a font size change drops everything.
+struct IntLabel {
+	int value = 0;
+	bool valid = false;
+	int length = 0;
+	char text[12] = "";
+	ImVec2 size;
+	unsigned lastUse = 0;
+};
+
+class IntLabelCache {
+public:
+	// The label stays valid until the next call
+	const IntLabel& get(int value) {
+		float fontSize = ImGui::GetFontSize();
+		if (fontSize != cachedFontSize) {
+			for (IntLabel& label : labels) label.valid = false;
+			cachedFontSize = fontSize;
+		}
+
+		size_t start = (uint32_t)((uint32_t)value * 2654435761u) >> (32 - capacityBits);
+		IntLabel* victim = nullptr;
+		for (size_t i = 0; i < probeLength; ++i) {
+			IntLabel& label = labels[(start + i) & (capacity - 1)];
+			if (label.valid && label.value == value) {
+				label.lastUse = ++uses;
+				return label;
+			}
+			// Prefer an empty entry, then the least recently used
+			if (!victim || (victim->valid && (!label.valid || label.lastUse < victim->lastUse))) victim = &label;
+		}
+
+		victim->length = std::snprintf(victim->text, sizeof(victim->text), "%d", value);
+		victim->size = ImGui::CalcTextSize(victim->text, victim->text + victim->length);
+		victim->value = value;
+		victim->valid = true;
+		victim->lastUse = ++uses;
+		formatted++;
+		return *victim;
+	}
+
+	size_t formatted = 0; // Labels formatted and measured so far
+
+private:
+	static const int capacityBits = 10;
+	static const size_t capacity = (size_t)1 << capacityBits;
+	static const size_t probeLength = 8;
+	IntLabel labels[capacity];
+	float cachedFontSize = 0.0f;
+	unsigned uses = 0;
+};
+IntLabelCache intLabels;
+
 void RenderLinkedList(LinkedList& list) {
 	static int inputValue = 0;
 	static int position = 0;
 	static std::string message = "";
+	static int mergesPerSecond = 4;
+	static float mergeBudget = 0.0f;
+	static int benchmarkNodes = 1000000;
 
 	// UI Window for controls (Resizable and Movable Window)
 	ImGui::Begin("Linked List");
@@ -126,30 +617,77 @@ void RenderLinkedList(LinkedList& list) {
 	ImGui::InputInt("Node Value", &inputValue);
 	ImGui::InputInt("Position (0 for beginning)", &position);
 
+	// The list can't be edited while a sort is relinking it or a script replaces it
+	bool sorting = linkedListSorter.active();
+	bool locked = sorting || batchScriptRunning();
+
 	// Buttons for insertion operations
-	if (ImGui::Button("Insert at Beginning")) {
+	if (sorting) {
+		ImGui::Text("Merging runs of %zu node(s)...", linkedListSorter.runWidth());
+	}
+	else if (locked) {
+		ImGui::Text("Batch script running...");
+	}
+	else if (ImGui::Button("Insert at Beginning")) {
 		list.insertAtBeginning(inputValue);
 		message = "Inserted " + std::to_string(inputValue) + " at the beginning.";
 	}
 
 	ImGui::SameLine();
-	if (ImGui::Button("Insert at End")) {
+	if (!locked && ImGui::Button("Insert at End")) {
 		list.insertAtEnd(inputValue);
 		message = "Inserted " + std::to_string(inputValue) + " at the end.";
 	}
 
 	ImGui::SameLine();
-	if (ImGui::Button("Insert at Position")) {
+	if (!locked && ImGui::Button("Insert at Position")) {
 		list.insertAtPosition(inputValue, position);
 		message = "Inserted " + std::to_string(inputValue) + " at position " + std::to_string(position) + ".";
 	}
 
 	// Button for deletion operation
-	if (ImGui::Button("Delete at Position")) {
+	if (!locked && ImGui::Button("Delete at Position")) {
 		list.deleteAtPosition(position);
 		message = "Deleted node at position " + std::to_string(position) + ".";
 	}
 
+	// In-place merge sort, animated one merge at a time
+	ImGui::SliderInt("Merges per second", &mergesPerSecond, 1, 1000);
+	if (!locked && ImGui::Button("Merge Sort (relink)")) {
+		linkedListSorter.begin(list);
+		mergeBudget = 0.0f;
+		message = "Sorting by relinking next pointers.";
+	}
+	if (sorting) {
+		if (ImGui::Button("Finish Sort")) {
+			linkedListSorter.finish();
+		}
+		mergeBudget += ImGui::GetIO().DeltaTime * mergesPerSecond;
+		while (mergeBudget >= 1.0f && linkedListSorter.step()) {
+			mergeBudget -= 1.0f;
+		}
+		if (!linkedListSorter.active()) {
+			message = "Sorted.";
+		}
+	}
+
+	// Relinking vs. copying to a vector and std::sort on large lists
+	ImGui::InputInt("Benchmark nodes", &benchmarkNodes, 100000, 1000000);
+	if (!listSortBenchmark.running && ImGui::Button("Run Sort Benchmark")) {
+		startListSortBenchmark(std::max(1, benchmarkNodes));
+	}
+	if (listSortBenchmark.running) {
+		ImGui::Text("Benchmarking %d nodes...", listSortBenchmark.nodes);
+	}
+	else if (listSortBenchmark.outOfMemory) {
+		ImGui::Text("%d nodes: out of memory, try fewer nodes", listSortBenchmark.nodes);
+	}
+	else if (listSortBenchmark.nodes > 0) {
+		ImGui::Text("%d nodes: relink %.1f ms (%zu allocations), vector + std::sort %.1f ms (%zu allocations)%s",
+			listSortBenchmark.nodes, listSortBenchmark.relinkMs, listSortBenchmark.relinkAllocations,
+			listSortBenchmark.copyMs, listSortBenchmark.copyAllocations, listSortBenchmark.sorted ? "" : " NOT SORTED");
+	}
+
 	// Display the message
 	if (!message.empty()) {
 		ImGui::Text("%s", message.c_str());
@@ -169,18 +707,23 @@ void RenderLinkedList(LinkedList& list) {
 	float radius = 40.0f;           // Node circle radius
 	float xOffset = 150.0f;         // Horizontal spacing between nodes
 	ImU32 nodeColor = IM_COL32(0, 102, 255, 255); // Blue color for nodes
+	ImU32 runColor = IM_COL32(0, 200, 100, 255);  // Green for the run just merged
 	ImU32 arrowColor = IM_COL32(255, 255, 255, 255);
 	ImU32 textColor = IM_COL32(255, 255, 255, 255);
 
+	const size_t maxVisibleNodes = 48; // Lists built by scripts can hold millions of nodes
+	size_t drawn = 0;
+	bool inRun = false;
 	Node* temp = list.head;
-	while (temp) {
+	while (temp && drawn < maxVisibleNodes) {
 		// Draw the node circle
-		drawList->AddCircleFilled(ImVec2(x, y), radius, nodeColor);
+		if (temp == linkedListSorter.lastRunStart()) inRun = true;
+		drawList->AddCircleFilled(ImVec2(x, y), radius, inRun ? runColor : nodeColor);
+		if (temp == linkedListSorter.lastRunEnd()) inRun = false;
 
 		// Draw the value inside the node
-		std::string valueStr = std::to_string(temp->data);
-		ImVec2 textSize = ImGui::CalcTextSize(valueStr.c_str());
-		drawList->AddText(ImVec2(x - textSize.x / 2, y - textSize.y / 2), textColor, valueStr.c_str());
+		const IntLabel& label = intLabels.get(temp->data);
+		drawList->AddText(ImVec2(x - label.size.x / 2, y - label.size.y / 2), textColor, label.text, label.text + label.length);
 
 		// Draw an arrow to the next node
 		if (temp->next) {
@@ -194,6 +737,7 @@ void RenderLinkedList(LinkedList& list) {
 
 		x += xOffset; // Move to the next node position
 		temp = temp->next;
+		drawn++;
 
 		// Wrap nodes to the next line if they exceed the window width
 		if (x + radius > canvasPos.x + canvasSize.x - 50) {
@@ -202,6 +746,10 @@ void RenderLinkedList(LinkedList& list) {
 		}
 	}
 
+	if (temp) {
+		ImGui::Text("... and %zu more nodes (%zu total)", list.count - drawn, list.count);
+	}
+
 	ImGui::End();
 }
 
@@ -211,6 +759,9 @@ void RenderLinkedList(LinkedList& list) {
 std::vector<int> data;
 int numValues = 50;
 int sortSpeed = 50; // Speed control (milliseconds)
+int sortAlgorithm = 0;          // Index into the sorting view's algorithm list
+int sortValueCount = 50;        // Values the sorting view generates
+const int sortAlgorithmCount = 6;
 bool isSorting = false;         // Indicates if sorting is in progress
 bool isPaused = false;          // Indicates if sorting is paused
 std::thread sortingThread;      // Thread for running sorting algorithms
@@ -219,227 +770,415 @@ std::thread sortingThread;      // Thread for running sorting algorithms
 int compareIndex1 = -1;         // First index being compared
 int compareIndex2 = -1;         // Second index being compared
 
-// Function to generate random data with a parameter
-void generateRandomData(int numValues) {
-	data.clear();
-	for (int i = 0; i < numValues; ++i) {
-		data.push_back(rand() % 100 + 1); // Random values between 1 and 100
+// Step gate used by headless capture: instead of sleeping, the sorting thread
+// parks after every step until the capture loop releases more steps, so the
+// animation advances by simulated time rather than wall-clock time.
+struct SortStepGate {
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool enabled = false;
+	long long released = 0;  // Steps the capture loop allowed
+	long long completed = 0; // Steps the sorting thread finished
+};
+SortStepGate sortStepGate;
+
+// Called by the sorting algorithms after every visualized step
+void sortStepDelay() {
+	if (!sortStepGate.enabled) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
+		return;
 	}
+	std::unique_lock<std::mutex> lock(sortStepGate.mutex);
+	sortStepGate.completed++;
+	sortStepGate.cv.notify_all();
+	sortStepGate.cv.wait(lock, []() { return sortStepGate.released >= sortStepGate.completed || !isSorting; });
 }
 
-// Sorting visualization
+// Lets the sorting thread run n more steps and waits until it parks again (or finishes)
+void releaseSortSteps(long long n) {
+	std::unique_lock<std::mutex> lock(sortStepGate.mutex);
+	sortStepGate.released += n;
+	sortStepGate.cv.notify_all();
+	// The algorithms clear isSorting without notifying, so poll for it
+	while (!sortStepGate.cv.wait_for(lock, std::chrono::milliseconds(1),
+		[]() { return sortStepGate.completed > sortStepGate.released || !isSorting; })) {
+	}
+}
 
-void bubbleSort() {
-	for (size_t i = 0; i < data.size(); ++i) {
-		if (!isSorting) return;
-		for (size_t j = 0; j < data.size() - i - 1; ++j) {
-			compareIndex1 = j;
-			compareIndex2 = j + 1;
+// Element types the sorting view can sort
+enum SortElementType { ElementInt32, ElementInt64, ElementFloat, ElementKeyValue };
 
-			if (data[j] > data[j + 1]) {
-				std::swap(data[j], data[j + 1]);
-			}
+// Key-value element, ordered by key; the value records the position before the
+// sort, so bars shaded by it and the check after the sort show stability
+struct KeyValue {
+	int key;
+	int value;
+};
 
-			std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
-		}
+inline bool operator<(const KeyValue& a, const KeyValue& b) {
+	return a.key < b.key;
+}
+
+// Value used for bar heights and colors
+inline double barValue(int v) { return v; }
+inline double barValue(int64_t v) { return (double)v; }
+inline double barValue(float v) { return v; }
+inline double barValue(const KeyValue& v) { return v.key; }
+
+// Fraction used for bar colors: the bar height, except for key-value bars, which
+// are shaded by position before the sort so a stable result leaves every group of
+// equal keys as a smooth gradient
+template <typename T>
+inline float barShade(const T&, float normalizedValue, size_t) { return normalizedValue; }
+inline float barShade(const KeyValue& v, float, size_t count) { return count > 1 ? (float)v.value / (count - 1) : 0.0f; }
+
+// Key-value sorts: 1 if the last visual sort kept equal keys in order, 0 if it
+// reordered them, -1 if not checked
+std::atomic<int> lastSortStable{ -1 };
+
+// Numbers key-value elements by position right before a sort
+template <typename T>
+void markSortPositions(std::vector<T>&) {}
+void markSortPositions(std::vector<KeyValue>& values) {
+	for (size_t i = 0; i < values.size(); ++i) values[i].value = (int)i;
+}
+
+template <typename T>
+void checkSortStability(const std::vector<T>&) {}
+void checkSortStability(const std::vector<KeyValue>& values) {
+	bool stable = true;
+	for (size_t i = 1; i < values.size() && stable; ++i) {
+		stable = values[i].key != values[i - 1].key || values[i].value > values[i - 1].value;
+	}
+	lastSortStable = stable ? 1 : 0;
+}
+
+// One vector per element type; 'data' holds the int32 values
+std::vector<int64_t> data64;
+std::vector<float> dataFloat;
+std::vector<KeyValue> dataKeyValue;
+int elementType = ElementInt32;
+
+template <typename T> std::vector<T>& sortData();
+template <> std::vector<int>& sortData<int>() { return data; }
+template <> std::vector<int64_t>& sortData<int64_t>() { return data64; }
+template <> std::vector<float>& sortData<float>() { return dataFloat; }
+template <> std::vector<KeyValue>& sortData<KeyValue>() { return dataKeyValue; }
+
+// Calls f with the vector of the given element type
+template <typename F>
+void withSortData(int type, F f) {
+	switch (type) {
+	case ElementInt32: f(data); break;
+	case ElementInt64: f(data64); break;
+	case ElementFloat: f(dataFloat); break;
+	case ElementKeyValue: f(dataKeyValue); break;
 	}
-	compareIndex1 = compareIndex2 = -1; // Reset indices
-	isSorting = false;
 }
 
+// Random element in the range the bars are scaled for
+inline void randomElement(int& out, int) { out = rand() % 100 + 1; }
+inline void randomElement(int64_t& out, int) { out = (int64_t)(rand() % 100 + 1) * 1000000000LL; }
+inline void randomElement(float& out, int) { out = (rand() % 10000 + 1) / 100.0f; }
+inline void randomElement(KeyValue& out, int index) { out.key = rand() % 100 + 1; out.value = index; }
+
+// Parses one custom value token
+inline void parseElement(int& out, const char* token, int) { out = std::atoi(token); }
+inline void parseElement(int64_t& out, const char* token, int) { out = std::strtoll(token, nullptr, 10); }
+inline void parseElement(float& out, const char* token, int) { out = std::strtof(token, nullptr); }
+inline void parseElement(KeyValue& out, const char* token, int index) { out.key = std::atoi(token); out.value = index; }
+
+// Random element over the whole range of the type, for benchmarks
+inline void benchmarkElement(int& out, std::mt19937& rng, int) { out = (int)rng(); }
+inline void benchmarkElement(int64_t& out, std::mt19937& rng, int) { out = (int64_t)(((uint64_t)rng() << 32) | rng()); }
+inline void benchmarkElement(float& out, std::mt19937& rng, int) { out = std::uniform_real_distribution<float>(-1e9f, 1e9f)(rng); }
+inline void benchmarkElement(KeyValue& out, std::mt19937& rng, int index) { out.key = (int)rng(); out.value = index; }
+
+template <typename T>
+void fillRandom(std::vector<T>& values, int count) {
+	values.resize(std::max(0, count));
+	for (int i = 0; i < (int)values.size(); ++i) {
+		randomElement(values[i], i);
+	}
+}
 
-void selectionSort() {
-	for (size_t i = 0; i < data.size(); ++i) {
-		size_t minIndex = i;
-		if (!isSorting) return;
-		for (size_t j = i + 1; j < data.size(); ++j) {
-			compareIndex1 = minIndex; // Current minimum
-			compareIndex2 = j;       // Element being compared
+// Frees the vectors of the element types not shown, so the memory panel's Sort
+// Data row (live bytes against the current type's element count) stays accurate
+void releaseInactiveSortData() {
+	if (elementType != ElementInt32) std::vector<int>().swap(data);
+	if (elementType != ElementInt64) std::vector<int64_t>().swap(data64);
+	if (elementType != ElementFloat) std::vector<float>().swap(dataFloat);
+	if (elementType != ElementKeyValue) std::vector<KeyValue>().swap(dataKeyValue);
+}
 
-			if (data[j] < data[minIndex]) {
-				minIndex = j; // Update the minimum index
+// Function to generate random data with a parameter
+void generateRandomData(int numValues) {
+	AllocScope scope(TagSortData);
+	withSortData(elementType, [numValues](auto& values) { fillRandom(values, numValues); });
+	releaseInactiveSortData(); // Switching type regenerates through here
+}
+
+// Instrumentation policies. The sorts report every comparison, element move and
+// step to an observer; NoObserver's members are empty inline functions, so an
+// unobserved sort compiles to the same code as one written without them.
+struct NoObserver {
+	void compare(int, int) {}
+	void move(int = 1) {}
+	void step() {}
+	bool cancelled() const { return false; }
+};
+
+struct CountingObserver {
+	long long comparisons = 0;
+	long long moves = 0;
+	void compare(int, int) { comparisons++; }
+	void move(int n = 1) { moves += n; }
+	void step() {}
+	bool cancelled() const { return false; }
+};
+
+// Drives the sorting window: highlights compared bars and paces each step
+struct VisualObserver {
+	void compare(int i, int j) {
+		compareIndex1 = i;
+		compareIndex2 = j;
+	}
+	void move(int = 1) {}
+	void step() { sortStepDelay(); }
+	bool cancelled() const { return !isSorting; }
+};
+
+// Sorting visualization
+
+template <typename T, typename Less, typename Observer>
+void bubbleSort(std::vector<T>& a, Less less, Observer& observer) {
+	int n = (int)a.size();
+	for (int i = 0; i < n; ++i) {
+		if (observer.cancelled()) return;
+		for (int j = 0; j < n - i - 1; ++j) {
+			observer.compare(j, j + 1);
+			if (less(a[j + 1], a[j])) {
+				std::swap(a[j], a[j + 1]);
+				observer.move(2);
 			}
+			observer.step();
+		}
+	}
+}
 
-			std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
+template <typename T, typename Less, typename Observer>
+void selectionSort(std::vector<T>& a, Less less, Observer& observer) {
+	int n = (int)a.size();
+	for (int i = 0; i < n; ++i) {
+		int minIndex = i;
+		if (observer.cancelled()) return;
+		for (int j = i + 1; j < n; ++j) {
+			observer.compare(minIndex, j); // Current minimum and element being compared
+			if (less(a[j], a[minIndex])) {
+				minIndex = j; // Update the minimum index
+			}
+			observer.step();
 		}
 
 		if (minIndex != i) {
-			std::swap(data[i], data[minIndex]);
+			std::swap(a[i], a[minIndex]);
+			observer.move(2);
 		}
 	}
+}
 
-	compareIndex1 = compareIndex2 = -1; // Reset indices
-	isSorting = false;
+template <typename T, typename Less, typename Observer>
+void insertionSort(std::vector<T>& a, Less less, Observer& observer) {
+	int n = (int)a.size();
+	for (int i = 1; i < n; ++i) {
+		if (observer.cancelled()) return;
+		T key = a[i];
+		int j = i - 1;
+
+		observer.compare(i, j); // Element being inserted
+		while (j >= 0 && less(key, a[j])) {
+			a[j + 1] = a[j]; // Shift element
+			observer.move();
+			j--;
+			observer.step();
+			observer.compare(i, j);
+		}
+
+		a[j + 1] = key; // Insert the key at the correct position
+		observer.move();
+	}
 }
 
-void merge(int left, int mid, int right) {
-	std::vector<int> temp(right - left + 1);
+// Merges a[left..mid] and a[mid+1..right] through a scratch buffer sized once by mergeSort
+template <typename T, typename Less, typename Observer>
+void merge(std::vector<T>& a, std::vector<T>& scratch, int left, int mid, int right, Less less, Observer& observer) {
 	int i = left, j = mid + 1, k = 0;
 
 	while (i <= mid && j <= right) {
-		compareIndex1 = i;
-		compareIndex2 = j;
-
-		if (data[i] <= data[j]) {
-			temp[k++] = data[i++];
+		observer.compare(i, j);
+		if (!less(a[j], a[i])) {
+			scratch[k++] = a[i++];
 		}
 		else {
-			temp[k++] = data[j++];
+			scratch[k++] = a[j++];
 		}
-
-		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
+		observer.move();
+		observer.step();
 	}
 
 	while (i <= mid) {
-		compareIndex1 = i;
-		temp[k++] = data[i++];
-		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
+		observer.compare(i, -1);
+		scratch[k++] = a[i++];
+		observer.move();
+		observer.step();
 	}
 
 	while (j <= right) {
-		compareIndex2 = j;
-		temp[k++] = data[j++];
-		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
+		observer.compare(-1, j);
+		scratch[k++] = a[j++];
+		observer.move();
+		observer.step();
 	}
 
-	for (int t = 0; t < temp.size(); ++t) {
-		data[left + t] = temp[t];
-	}
+	std::copy(scratch.begin(), scratch.begin() + k, a.begin() + left);
+	observer.move(k);
 }
 
-void mergeSortHelper(int left, int right) {
-	if (!isSorting) return;
+template <typename T, typename Less, typename Observer>
+void mergeSortHelper(std::vector<T>& a, std::vector<T>& scratch, int left, int right, Less less, Observer& observer) {
+	if (observer.cancelled()) return;
 	if (left >= right) return;
 
 	int mid = left + (right - left) / 2;
 
-	mergeSortHelper(left, mid);
-	mergeSortHelper(mid + 1, right);
+	mergeSortHelper(a, scratch, left, mid, less, observer);
+	mergeSortHelper(a, scratch, mid + 1, right, less, observer);
 
-	merge(left, mid, right);
+	merge(a, scratch, left, mid, right, less, observer);
 }
 
-void mergeSort() {
-	mergeSortHelper(0, data.size() - 1);
-	compareIndex1 = compareIndex2 = -1; // Reset indices
-	isSorting = false;
+template <typename T, typename Less, typename Observer>
+void mergeSort(std::vector<T>& a, Less less, Observer& observer) {
+	std::vector<T> scratch(a.size());
+	mergeSortHelper(a, scratch, 0, (int)a.size() - 1, less, observer);
 }
 
-int partition(int low, int high) {
-	int pivot = data[high];
-	int i = low - 1;
-
-	for (int j = low; j < high; ++j) {
-		compareIndex1 = j;
-		compareIndex2 = high; // Pivot
-
-		if (data[j] < pivot) {
+// Three-way partition around the value of a[high]: afterwards a[low..lt-1] is
+// less than the pivot, a[lt..gt] equal to it and a[gt+1..high] greater, so keys
+// that repeat a lot are finished in one pass instead of going quadratic
+template <typename T, typename Less, typename Observer>
+void partition(std::vector<T>& a, int low, int high, int& lt, int& gt, Less less, Observer& observer) {
+	T pivot = a[high];
+	observer.move();
+	lt = low;
+	gt = high;
+	int i = low;
+	while (i <= gt) {
+		observer.compare(i, gt);
+		if (less(a[i], pivot)) {
+			std::swap(a[lt], a[i]);
+			observer.move(2);
+			lt++;
 			i++;
-			std::swap(data[i], data[j]);
 		}
-
-		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
+		else {
+			observer.compare(i, gt);
+			if (less(pivot, a[i])) {
+				std::swap(a[i], a[gt]);
+				observer.move(2);
+				gt--;
+			}
+			else {
+				i++;
+			}
+		}
+		observer.step();
 	}
-
-	std::swap(data[i + 1], data[high]);
-	return i + 1;
 }
 
-void quickSortHelper(int low, int high) {
-	if (!isSorting) return;
+template <typename T, typename Less, typename Observer>
+void quickSortHelper(std::vector<T>& a, int low, int high, Less less, Observer& observer) {
+	if (observer.cancelled()) return;
 	if (low < high) {
-		int pi = partition(low, high);
+		int lt, gt;
+		partition(a, low, high, lt, gt, less, observer);
 
-		quickSortHelper(low, pi - 1);
-		quickSortHelper(pi + 1, high);
+		quickSortHelper(a, low, lt - 1, less, observer);
+		quickSortHelper(a, gt + 1, high, less, observer);
 	}
 }
 
-void quickSort() {
-	quickSortHelper(0, data.size() - 1);
-	compareIndex1 = compareIndex2 = -1; // Reset indices
-	isSorting = false;
+template <typename T, typename Less, typename Observer>
+void quickSort(std::vector<T>& a, Less less, Observer& observer) {
+	quickSortHelper(a, 0, (int)a.size() - 1, less, observer);
 }
 
-void heapify(int n, int i) {
-	int largest = i;
-	int left = 2 * i + 1;
-	int right = 2 * i + 2;
-
-	compareIndex1 = i;
-
-	if (left < n && data[left] > data[largest]) {
-		largest = left;
-	}
-
-	compareIndex2 = largest;
+template <typename T, typename Less, typename Observer>
+void heapify(std::vector<T>& a, int n, int i, Less less, Observer& observer) {
+	while (true) {
+		int largest = i;
+		int left = 2 * i + 1;
+		int right = 2 * i + 2;
 
-	if (right < n && data[right] > data[largest]) {
-		largest = right;
-	}
+		if (left < n) {
+			observer.compare(i, left);
+			if (less(a[largest], a[left])) largest = left;
+		}
+		if (right < n) {
+			observer.compare(largest, right);
+			if (less(a[largest], a[right])) largest = right;
+		}
+		if (largest == i) return;
 
-	if (largest != i) {
-		std::swap(data[i], data[largest]);
-		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
-		heapify(n, largest);
+		std::swap(a[i], a[largest]);
+		observer.move(2);
+		observer.step();
+		i = largest;
 	}
 }
 
-void heapSort() {
-	int n = data.size();
+template <typename T, typename Less, typename Observer>
+void heapSort(std::vector<T>& a, Less less, Observer& observer) {
+	int n = (int)a.size();
 
 	for (int i = n / 2 - 1; i >= 0; --i) {
-		if (!isSorting) return;
-		heapify(n, i);
+		if (observer.cancelled()) return;
+		heapify(a, n, i, less, observer);
 	}
 
-	for (int i = n - 1; i >= 0; --i) {
-		if (!isSorting) return;
-		std::swap(data[0], data[i]);
-		compareIndex1 = 0;
-		compareIndex2 = i;
-		std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
-		heapify(i, 0);
+	for (int i = n - 1; i > 0; --i) {
+		if (observer.cancelled()) return;
+		std::swap(a[0], a[i]);
+		observer.move(2);
+		observer.compare(0, i);
+		observer.step();
+		heapify(a, i, 0, less, observer);
 	}
-
-	compareIndex1 = compareIndex2 = -1; // Reset indices
-	isSorting = false;
 }
 
-
-void insertionSort() {
-	for (size_t i = 1; i < data.size(); ++i) {
-		int key = data[i];
-		size_t j = i - 1;
-
-		compareIndex1 = i; // Element being inserted
-
-		while (j < data.size() && data[j] > key) { // Comparison
-			compareIndex2 = j;
-
-			data[j + 1] = data[j]; // Shift element
-			j--;
-
-			std::this_thread::sleep_for(std::chrono::milliseconds(sortSpeed));
-		}
-
-		data[j + 1] = key; // Insert the key at the correct position
-
-		// Reset comparison indices after each insertion
-		compareIndex1 = compareIndex2 = -1;
+// Runs the algorithm at the given index of the sorting window's list
+template <typename T, typename Less, typename Observer>
+void runSort(int algorithm, std::vector<T>& a, Less less, Observer& observer) {
+	switch (algorithm) {
+	case 0: bubbleSort(a, less, observer); break;
+	case 1: selectionSort(a, less, observer); break;
+	case 2: insertionSort(a, less, observer); break;
+	case 3: mergeSort(a, less, observer); break;
+	case 4: quickSort(a, less, observer); break;
+	case 5: heapSort(a, less, observer); break;
 	}
-
-	compareIndex1 = compareIndex2 = -1; // Final reset
-	isSorting = false;
 }
 
 // for rendering data bars
 
-void renderDataBars(ImDrawList* drawList, ImVec2 canvasPos, ImVec2 canvasSize) {
-	if (data.empty()) return;
+template <typename T>
+void renderDataBars(const std::vector<T>& values, ImDrawList* drawList, ImVec2 canvasPos, ImVec2 canvasSize) {
+	if (values.empty()) return;
 
-	float maxValue = *std::max_element(data.begin(), data.end());
-	float barWidth = canvasSize.x / data.size(); // Calculate the width of each bar
+	float maxValue = 0.0f;
+	for (const T& v : values) maxValue = std::max(maxValue, (float)barValue(v));
+	if (maxValue <= 0.0f) maxValue = 1.0f;
+	float barWidth = canvasSize.x / values.size(); // Calculate the width of each bar
 	float barHeightScale = canvasSize.y / maxValue;
 
 	// Set a minimum bar width for visibility
@@ -447,14 +1186,15 @@ void renderDataBars(ImDrawList* drawList, ImVec2 canvasPos, ImVec2 canvasSize) {
 		barWidth = 1.0f; // Ensure bars are at least 1 pixel wide
 	}
 
-	for (size_t i = 0; i < data.size(); ++i) {
+	for (size_t i = 0; i < values.size(); ++i) {
+		float value = (float)barValue(values[i]);
 		float x0 = canvasPos.x + i * barWidth;
 		float x1 = x0 + barWidth;
 		float y1 = canvasPos.y + canvasSize.y;
-		float y0 = y1 - data[i] * barHeightScale;
+		float y0 = y1 - value * barHeightScale;
 
 		// Generate a color based on the value of the bar
-		float normalizedValue = static_cast<float>(data[i]) / maxValue; // Range: 0 to 1
+		float normalizedValue = barShade(values[i], value / maxValue, values.size()); // Range: 0 to 1
 		ImU32 color = IM_COL32(
 			static_cast<int>(normalizedValue * 50),          // Red component
 			static_cast<int>(normalizedValue * 255),         // Green component
@@ -463,7 +1203,7 @@ void renderDataBars(ImDrawList* drawList, ImVec2 canvasPos, ImVec2 canvasSize) {
 		);
 
 		// Highlight compared bars in red
-		if (i == compareIndex1 || i == compareIndex2) {
+		if ((int)i == compareIndex1 || (int)i == compareIndex2) {
 			color = IM_COL32(255, 0, 0, 255); // Red for highlighted bars
 		}
 
@@ -478,11 +1218,83 @@ void renderDataBars(ImDrawList* drawList, ImVec2 canvasPos, ImVec2 canvasSize) {
 }
 
 void shuffleData() {
-	std::random_shuffle(data.begin(), data.end());
+	withSortData(elementType, [](auto& values) { std::random_shuffle(values.begin(), values.end()); });
+}
+
+// Times the unobserved and counting instantiations of an algorithm against
+// std::sort on a private copy of random data, off the UI thread
+struct SortBenchmark {
+	std::thread worker;
+	std::atomic<bool> running{ false };
+	int algorithm = 0;
+	int type = ElementInt32;
+	int size = 0;
+	double unobservedMs = 0.0;
+	double stdSortMs = 0.0;
+	long long comparisons = 0;
+	long long moves = 0;
+	bool sorted = false;
+	bool outOfMemory = false; // The data didn't fit; the results are stale
+};
+SortBenchmark sortBenchmark;
+
+// Benchmark inputs come from a private generator (rand() isn't thread-safe) and
+// span the whole range of the type rather than the bars' 1..100
+template <typename T>
+void runSortBenchmark(int size) {
+	resetAllocPeak(TagSorting);
+	AllocScope scope(TagSorting);
+	std::vector<T> input(std::max(0, size));
+	std::mt19937 rng(12345);
+	for (int i = 0; i < (int)input.size(); ++i) benchmarkElement(input[i], rng, i);
+
+	std::vector<T> a = input;
+	auto start = std::chrono::high_resolution_clock::now();
+	NoObserver none;
+	runSort(sortBenchmark.algorithm, a, std::less<T>(), none);
+	sortBenchmark.unobservedMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	sortBenchmark.sorted = std::is_sorted(a.begin(), a.end());
+
+	a = input;
+	CountingObserver counter;
+	runSort(sortBenchmark.algorithm, a, std::less<T>(), counter);
+	sortBenchmark.comparisons = counter.comparisons;
+	sortBenchmark.moves = counter.moves;
+
+	a = input;
+	start = std::chrono::high_resolution_clock::now();
+	std::sort(a.begin(), a.end());
+	sortBenchmark.stdSortMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 }
+
+void startSortBenchmark(int algorithm, int type, int size) {
+	if (sortBenchmark.running) return;
+	if (sortBenchmark.worker.joinable()) sortBenchmark.worker.join();
+	sortBenchmark.algorithm = algorithm;
+	sortBenchmark.type = type;
+	sortBenchmark.size = size;
+	sortBenchmark.outOfMemory = false;
+	sortBenchmark.running = true;
+	sortBenchmark.worker = std::thread([type, size]() {
+		try {
+			switch (type) {
+			case ElementInt32: runSortBenchmark<int>(size); break;
+			case ElementInt64: runSortBenchmark<int64_t>(size); break;
+			case ElementFloat: runSortBenchmark<float>(size); break;
+			case ElementKeyValue: runSortBenchmark<KeyValue>(size); break;
+			}
+		}
+		catch (const std::bad_alloc&) {
+			sortBenchmark.outOfMemory = true;
+		}
+		sortBenchmark.running = false;
+		});
+}
+
 void stopSorting() {
 	if (isSorting) {
 		isSorting = false; // Stop the sorting process
+		sortStepGate.cv.notify_all(); // Wake a thread parked by headless capture
 		if (sortingThread.joinable()) {
 			sortingThread.join(); // Wait for the thread to finish
 		}
@@ -490,57 +1302,663 @@ void stopSorting() {
 	compareIndex1 = compareIndex2 = -1; // Reset indices
 }
 
-void RenderSorting() {
-	static int count = 50;
-	static char userValues[1024] = "";
-	static const char* sortNames[] = { "Bubble Sort", "Selection Sort", "Insertion Sort", "Merge Sort", "Quick Sort", "Heap Sort" };
-	static int selectedAlgorithm = 0; // Index of the selected algorithm
-
-	ImGui::Begin("Sorting");
+template <typename T>
+void runVisualSort(int algorithm) {
+	AllocScope scope(TagSorting);
+	VisualObserver observer;
+	runSort(algorithm, sortData<T>(), std::less<T>(), observer);
+	if (isSorting) checkSortStability(sortData<T>()); // Skipped when stopped part way
+	compareIndex1 = compareIndex2 = -1; // Reset indices
+	isSorting = false;
+}
 
-	// Input controls
-	ImGui::InputInt("Values to generate", &count, 1, 100);
-	if (ImGui::Button("Generate Random Data")) {
-		generateRandomData(count);
-	}
-	ImGui::SameLine();
-	if (ImGui::Button("Shuffle Data")) {
-		shuffleData();
-	}
-	ImGui::InputText("Custom Values (space-separated)", userValues, sizeof(userValues));
-	if (ImGui::Button("Set Custom Data")) {
-		data.clear();
-		char* nextToken = nullptr;
-		char* token = strtok_s(userValues, " ", &nextToken);
-		while (token != nullptr) {
-			data.push_back(std::atoi(token));
-			token = strtok_s(nullptr, " ", &nextToken);
+void startSorting(int algorithm) {
+	isSorting = true;
+	resetAllocPeak(TagSorting);
+	lastSortStable = -1;
+	withSortData(elementType, [](auto& values) { markSortPositions(values); });
+
+	// Pass the algorithm and element type as values to the lambda
+	int type = elementType;
+	sortingThread = std::thread([algorithm, type]() {
+		switch (type) {
+		case ElementInt32: runVisualSort<int>(algorithm); break;
+		case ElementInt64: runVisualSort<int64_t>(algorithm); break;
+		case ElementFloat: runVisualSort<float>(algorithm); break;
+		case ElementKeyValue: runVisualSort<KeyValue>(algorithm); break;
 		}
-	}
+		});
+	sortingThread.detach();
+}
 
-	// Sorting algorithm selection
-	ImGui::Combo("Algorithm", &selectedAlgorithm, sortNames, IM_ARRAYSIZE(sortNames));
+// External Merge Sort
+//
+// Sorts a file of raw int32 values that may be larger than RAM. Run formation
+// reads memory-budgeted chunks on several threads, sorts them and writes each
+// as a run file; the merge phase streams the runs through a loser tree, with
+// every input and the output double-buffered by asynchronous reads/writes.
+
+enum ExternalRunState { RunReading, RunSorting, RunWriting, RunWritten, RunMerged };
+enum ExternalSortPhase { PhaseIdle, PhaseGenerating, PhaseForming, PhaseMerging, PhaseVerifying, PhaseDone, PhaseFailed };
+
+struct ExternalRun {
+	std::string path;
+	long long values = 0;
+	std::atomic<int> state{ RunReading };
+	std::atomic<long long> merged{ 0 }; // Values consumed by the merge
+	ExternalRun(const std::string& path) : path(path) {}
+};
 
-	// Speed control
-	ImGui::SliderInt("Speed (ms)", &sortSpeed, 1, 200);
+struct ExternalSortJob {
+	// Settings, fixed while the job runs
+	std::string input, output;
+	long long memoryBudget = 64LL << 20; // Bytes
+	int threads = 4;
+	long long generateValues = 0;        // Non-zero: write a random input file instead of sorting
+
+	std::thread worker;
+	std::atomic<bool> running{ false };
+	std::atomic<bool> cancel{ false };
+	std::atomic<int> phase{ PhaseIdle };
+	std::atomic<int> mergePass{ 0 };
+	std::atomic<int> mergePasses{ 0 };
+	std::atomic<long long> inputBytes{ 0 };
+	std::atomic<long long> bytesRead{ 0 };    // In the current phase
+	std::atomic<long long> bytesWritten{ 0 }; // In the current phase
+	std::atomic<long long> phaseStartMicros{ 0 };
+	std::atomic<long long> totalValues{ 0 };
+
+	std::mutex mutex; // Guards runs (elements stay put in a deque) and the results below
+	std::deque<ExternalRun> runs;
+	std::string error;
+	double formSeconds = 0.0, formMBps = 0.0;
+	double mergeSeconds = 0.0, mergeMBps = 0.0;
+	bool verified = false;
+};
+ExternalSortJob externalSort;
 
-	// Start sorting
-	if (!isSorting && ImGui::Button("Start Sorting")) {
-		isSorting = true;
-
-		// Pass selectedAlgorithm as a value to the lambda
-		int algorithm = selectedAlgorithm;
-		sortingThread = std::thread([algorithm]() {
-			switch (algorithm) {
-			case 0: bubbleSort(); break;
-			case 1: selectionSort(); break;
-			case 2: insertionSort(); break;
-			case 3: mergeSort(); break;
-			case 4: quickSort(); break;
-			case 5: heapSort(); break;
-			}
+long long steadyMicros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void externalFail(const std::string& message) {
+	std::lock_guard<std::mutex> lock(externalSort.mutex);
+	if (externalSort.error.empty()) externalSort.error = message;
+	externalSort.cancel = true;
+}
+
+void externalBeginPhase(int phase) {
+	externalSort.bytesRead = 0;
+	externalSort.bytesWritten = 0;
+	externalSort.phaseStartMicros = steadyMicros();
+	externalSort.phase = phase;
+}
+
+// Seconds and combined read+write bandwidth of the current phase
+void externalPhaseStats(double& seconds, double& mbps) {
+	seconds = (steadyMicros() - externalSort.phaseStartMicros) / 1e6;
+	mbps = seconds > 0.0 ? (externalSort.bytesRead + externalSort.bytesWritten) / seconds / 1e6 : 0.0;
+}
+
+// Reads a run in blocks, fetching the next block asynchronously while the
+// current one is being merged
+class RunReader {
+public:
+	~RunReader() {
+		close();
+	}
+
+	bool open(ExternalRun* source, size_t blockValues) {
+		run = source;
+		file = std::fopen(run->path.c_str(), "rb");
+		if (!file) return false;
+		front.resize(blockValues);
+		back.resize(blockValues);
+		count = std::fread(front.data(), sizeof(int), front.size(), file);
+		externalSort.bytesRead += count * sizeof(int);
+		pos = 0;
+		if (count > 0) startRead();
+		return true;
+	}
+
+	bool empty() const { return pos >= count; }
+	int head() const { return front[pos]; }
+
+	void advance() {
+		if (++pos >= count) refill();
+	}
+
+	void close() {
+		if (pending.valid()) pending.wait();
+		if (file) std::fclose(file);
+		file = nullptr;
+	}
+
+private:
+	void startRead() {
+		pending = std::async(std::launch::async, [this]() { return std::fread(back.data(), sizeof(int), back.size(), file); });
+	}
+
+	void refill() {
+		run->merged += count;
+		count = pending.valid() ? pending.get() : 0;
+		externalSort.bytesRead += count * sizeof(int);
+		front.swap(back);
+		pos = 0;
+		if (count > 0) startRead();
+	}
+
+	ExternalRun* run = nullptr;
+	std::FILE* file = nullptr;
+	std::vector<int> front, back;
+	size_t count = 0, pos = 0;
+	std::future<size_t> pending;
+};
+
+// Collects merged values in blocks and writes each block asynchronously while
+// the next one fills
+class BlockWriter {
+public:
+	~BlockWriter() {
+		finish();
+	}
+
+	bool open(const std::string& path, size_t blockValues) {
+		file = std::fopen(path.c_str(), "wb");
+		front.resize(blockValues);
+		back.resize(blockValues);
+		count = 0;
+		return file != nullptr;
+	}
+
+	void put(int value) {
+		front[count++] = value;
+		if (count == front.size()) flush();
+	}
+
+	// Returns false if any write failed
+	bool finish() {
+		if (!file) return !failed;
+		flush();
+		wait();
+		if (std::fclose(file) != 0) failed = true;
+		file = nullptr;
+		return !failed;
+	}
+
+private:
+	void wait() {
+		if (pending.valid() && !pending.get()) failed = true;
+	}
+
+	void flush() {
+		wait();
+		front.swap(back);
+		size_t n = count;
+		count = 0;
+		if (n == 0) return;
+		pending = std::async(std::launch::async, [this, n]() {
+			bool ok = std::fwrite(back.data(), sizeof(int), n, file) == n;
+			externalSort.bytesWritten += n * sizeof(int);
+			return ok;
+			});
+	}
+
+	std::FILE* file = nullptr;
+	std::vector<int> front, back;
+	size_t count = 0;
+	std::future<bool> pending;
+	bool failed = false;
+};
+
+// Tournament tree over k run readers: tree[0] holds the run with the smallest
+// head and each internal node the loser of the match played there, so
+// replacing the winner costs one path of log2(k) comparisons.
+class LoserTree {
+public:
+	LoserTree(std::vector<RunReader>& readers) : readers(readers), k((int)readers.size()), tree(std::max(1, k)) {
+		if (k > 0) tree[0] = build(1);
+	}
+
+	bool empty() const { return k == 0 || readers[tree[0]].empty(); }
+	int winner() const { return tree[0]; }
+
+	// Advances the winning run and replays its path to the root
+	void pop() {
+		int winner = tree[0];
+		readers[winner].advance();
+		for (int node = (winner + k) / 2; node >= 1; node /= 2) {
+			if (beats(tree[node], winner)) std::swap(tree[node], winner);
+		}
+		tree[0] = winner;
+	}
+
+private:
+	bool beats(int a, int b) const {
+		if (readers[a].empty()) return false;
+		if (readers[b].empty()) return true;
+		return readers[a].head() < readers[b].head() || (readers[a].head() == readers[b].head() && a < b);
+	}
+
+	// Leaves are nodes k..2k-1; returns the winner of the subtree at node
+	int build(int node) {
+		if (node >= k) return node - k;
+		int left = build(2 * node), right = build(2 * node + 1);
+		if (beats(left, right)) {
+			tree[node] = right;
+			return left;
+		}
+		tree[node] = left;
+		return right;
+	}
+
+	std::vector<RunReader>& readers;
+	int k;
+	std::vector<int> tree;
+};
+
+bool externalGenerate() {
+	externalBeginPhase(PhaseGenerating);
+	BlockWriter writer;
+	if (!writer.open(externalSort.input, 1 << 18)) {
+		externalFail("Could not create " + externalSort.input + ".");
+		return false;
+	}
+	std::mt19937 rng(12345);
+	for (long long i = 0; i < externalSort.generateValues && !externalSort.cancel; ++i) {
+		writer.put((int)rng());
+	}
+	if (!writer.finish()) {
+		externalFail("Could not write " + externalSort.input + ".");
+		return false;
+	}
+	return !externalSort.cancel;
+}
+
+// Phase 1: each thread reads the next chunk of its share of the memory budget,
+// sorts it and writes it out as a run; reads are serialized, sorting is not
+bool externalFormRuns() {
+	externalBeginPhase(PhaseForming);
+	std::FILE* in = std::fopen(externalSort.input.c_str(), "rb");
+	if (!in) {
+		externalFail("Could not open " + externalSort.input + ".");
+		return false;
+	}
+
+	std::mutex inputMutex;
+	bool inputDone = false;
+	size_t chunkValues = (size_t)std::max<long long>(1024, externalSort.memoryBudget / (long long)sizeof(int) / externalSort.threads);
+	auto formRuns = [&]() {
+		AllocScope scope(TagExternalSort);
+		std::vector<int> buffer(chunkValues);
+		while (!externalSort.cancel) {
+			ExternalRun* run = nullptr;
+			size_t n = 0;
+			{
+				std::lock_guard<std::mutex> lock(inputMutex);
+				if (inputDone) return;
+				n = std::fread(buffer.data(), sizeof(int), chunkValues, in);
+				if (n < chunkValues) inputDone = true;
+				if (n == 0) return;
+				std::lock_guard<std::mutex> runsLock(externalSort.mutex);
+				externalSort.runs.emplace_back(externalSort.output + ".run" + std::to_string(externalSort.runs.size()));
+				run = &externalSort.runs.back();
+				run->values = (long long)n;
+			}
+			externalSort.bytesRead += n * sizeof(int);
+			externalSort.totalValues += n;
+
+			run->state = RunSorting;
+			std::sort(buffer.begin(), buffer.begin() + n);
+			run->state = RunWriting;
+
+			std::FILE* out = std::fopen(run->path.c_str(), "wb");
+			bool ok = out && std::fwrite(buffer.data(), sizeof(int), n, out) == n;
+			if (out && std::fclose(out) != 0) ok = false;
+			if (!ok) {
+				externalFail("Could not write run file " + run->path + ".");
+				return;
+			}
+			externalSort.bytesWritten += n * sizeof(int);
+			run->state = RunWritten;
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < externalSort.threads; ++i) workers.emplace_back(formRuns);
+	for (std::thread& t : workers) t.join();
+	std::fclose(in);
+
+	std::lock_guard<std::mutex> lock(externalSort.mutex);
+	externalPhaseStats(externalSort.formSeconds, externalSort.formMBps);
+	return !externalSort.cancel;
+}
+
+// Merges the given runs into one file
+bool externalMergeRuns(const std::vector<ExternalRun*>& inputs, const std::string& outputPath) {
+	size_t k = inputs.size();
+	// Two blocks per input plus two for the output share the memory budget
+	size_t blockValues = (size_t)std::min<long long>(1 << 20,
+		std::max<long long>(1024, externalSort.memoryBudget / (long long)sizeof(int) / (2 * ((long long)k + 1))));
+
+	std::vector<RunReader> readers(k);
+	for (size_t i = 0; i < k; ++i) {
+		if (!readers[i].open(inputs[i], blockValues)) {
+			externalFail("Could not open run file " + inputs[i]->path + ".");
+			return false;
+		}
+	}
+	BlockWriter writer;
+	if (!writer.open(outputPath, blockValues)) {
+		externalFail("Could not create " + outputPath + ".");
+		return false;
+	}
+
+	LoserTree tree(readers);
+	for (size_t n = 0; !tree.empty(); ++n) {
+		writer.put(readers[tree.winner()].head());
+		tree.pop();
+		if ((n & 0xFFFF) == 0 && externalSort.cancel) break;
+	}
+	if (!writer.finish()) {
+		externalFail("Could not write " + outputPath + ".");
+		return false;
+	}
+
+	for (size_t i = 0; i < k; ++i) {
+		readers[i].close();
+		inputs[i]->state = RunMerged;
+		std::remove(inputs[i]->path.c_str());
+	}
+	return !externalSort.cancel;
+}
+
+// Phase 2: k-way merge. More runs than maxFanIn are merged in several passes so
+// the number of open files and buffers stays bounded.
+bool externalMerge() {
+	const size_t maxFanIn = 256;
+	externalBeginPhase(PhaseMerging);
+
+	std::vector<ExternalRun*> level;
+	{
+		std::lock_guard<std::mutex> lock(externalSort.mutex);
+		for (ExternalRun& run : externalSort.runs) level.push_back(&run);
+	}
+	int passes = 1;
+	for (size_t runs = level.size(); runs > maxFanIn; runs = (runs + maxFanIn - 1) / maxFanIn) passes++;
+	externalSort.mergePasses = passes;
+
+	for (int pass = 1; ; ++pass) {
+		externalSort.mergePass = pass;
+		if (level.size() <= maxFanIn) {
+			if (!externalMergeRuns(level, externalSort.output)) return false;
+			break;
+		}
+
+		std::vector<ExternalRun*> next;
+		for (size_t first = 0; first < level.size(); first += maxFanIn) {
+			std::vector<ExternalRun*> group(level.begin() + first, level.begin() + std::min(level.size(), first + maxFanIn));
+			ExternalRun* merged;
+			{
+				std::lock_guard<std::mutex> lock(externalSort.mutex);
+				externalSort.runs.emplace_back(externalSort.output + ".run" + std::to_string(externalSort.runs.size()));
+				merged = &externalSort.runs.back();
+				merged->state = RunWriting;
+				for (ExternalRun* run : group) merged->values += run->values;
+			}
+			if (!externalMergeRuns(group, merged->path)) return false;
+			merged->state = RunWritten;
+			next.push_back(merged);
+		}
+		level.swap(next);
+	}
+
+	std::lock_guard<std::mutex> lock(externalSort.mutex);
+	externalPhaseStats(externalSort.mergeSeconds, externalSort.mergeMBps);
+	return true;
+}
+
+// Streams the output once to confirm it is sorted and complete
+bool externalVerify() {
+	externalBeginPhase(PhaseVerifying);
+	std::FILE* in = std::fopen(externalSort.output.c_str(), "rb");
+	if (!in) {
+		externalFail("Could not open " + externalSort.output + " to verify it.");
+		return false;
+	}
+	std::vector<int> block(1 << 18);
+	long long total = 0;
+	bool sorted = true;
+	int previous = INT32_MIN;
+	size_t n;
+	while (sorted && !externalSort.cancel && (n = std::fread(block.data(), sizeof(int), block.size(), in)) > 0) {
+		externalSort.bytesRead += n * sizeof(int);
+		for (size_t i = 0; i < n; ++i) {
+			if (block[i] < previous) sorted = false;
+			previous = block[i];
+		}
+		total += n;
+	}
+	std::fclose(in);
+	if (externalSort.cancel) return false;
+	if (!sorted) {
+		externalFail("Verification failed: " + externalSort.output + " is not sorted.");
+		return false;
+	}
+	if (total != externalSort.totalValues) {
+		externalFail("Verification failed: " + externalSort.output + " holds " + std::to_string(total) +
+			" values, expected " + std::to_string((long long)externalSort.totalValues) + ".");
+		return false;
+	}
+	return true;
+}
+
+void startExternalSort(const std::string& input, const std::string& output, int memoryMB, int threads, long long generateValues) {
+	if (externalSort.running) return;
+	if (externalSort.worker.joinable()) externalSort.worker.join();
+
+	externalSort.input = input;
+	externalSort.output = output;
+	externalSort.memoryBudget = (long long)std::max(1, memoryMB) << 20;
+	externalSort.threads = std::max(1, threads);
+	externalSort.generateValues = generateValues;
+	externalSort.cancel = false;
+	externalSort.totalValues = 0;
+	externalSort.mergePass = 0;
+	externalSort.mergePasses = 0;
+	externalSort.inputBytes = 0;
+	externalSort.runs.clear();
+	externalSort.error.clear();
+	externalSort.formSeconds = externalSort.formMBps = 0.0;
+	externalSort.mergeSeconds = externalSort.mergeMBps = 0.0;
+	externalSort.verified = false;
+	externalSort.running = true;
+
+	resetAllocPeak(TagExternalSort);
+	externalSort.worker = std::thread([]() {
+		AllocScope scope(TagExternalSort);
+		bool ok;
+		if (externalSort.generateValues > 0) {
+			ok = externalGenerate();
+		}
+		else {
+			std::ifstream file(externalSort.input, std::ios::binary | std::ios::ate);
+			externalSort.inputBytes = file ? (long long)file.tellg() : 0;
+			ok = externalFormRuns() && externalMerge() && externalVerify();
+			if (ok) {
+				std::lock_guard<std::mutex> lock(externalSort.mutex);
+				externalSort.verified = true;
+			}
+		}
+		if (!ok) {
+			// Remove the run files and the partial output of a failed or cancelled
+			// job; the output is only touched once the final merge pass starts
+			std::lock_guard<std::mutex> lock(externalSort.mutex);
+			for (ExternalRun& run : externalSort.runs) {
+				if (run.state != RunMerged) std::remove(run.path.c_str());
+			}
+			if (externalSort.generateValues > 0) std::remove(externalSort.input.c_str());
+			else if (externalSort.mergePasses > 0 && externalSort.mergePass == externalSort.mergePasses) std::remove(externalSort.output.c_str());
+			if (externalSort.error.empty()) externalSort.error = "Cancelled.";
+		}
+		externalSort.phase = ok ? PhaseDone : PhaseFailed;
+		externalSort.running = false;
+		});
+}
+
+void stopExternalSort() {
+	externalSort.cancel = true;
+	if (externalSort.worker.joinable()) {
+		externalSort.worker.join();
+	}
+}
+
+// Draws one column per run: grey while being read, orange while sorting, purple
+// while being written, blue once written, with the part already consumed by the
+// merge in green
+void renderExternalRuns(ImDrawList* drawList, ImVec2 canvasPos, ImVec2 canvasSize) {
+	std::lock_guard<std::mutex> lock(externalSort.mutex);
+	if (externalSort.runs.empty()) return;
+
+	long long maxValues = 1;
+	for (const ExternalRun& run : externalSort.runs) maxValues = std::max(maxValues, run.values);
+	float columnWidth = std::max(1.0f, canvasSize.x / externalSort.runs.size());
+
+	size_t i = 0;
+	for (const ExternalRun& run : externalSort.runs) {
+		float x0 = canvasPos.x + i * columnWidth;
+		if (x0 >= canvasPos.x + canvasSize.x) break;
+		float x1 = x0 + std::max(1.0f, columnWidth - 1.0f);
+		float y1 = canvasPos.y + canvasSize.y;
+		float height = canvasSize.y * run.values / maxValues;
+
+		int state = run.state;
+		ImU32 color = state == RunReading ? IM_COL32(120, 120, 120, 255) :
+			state == RunSorting ? IM_COL32(255, 160, 0, 255) :
+			state == RunWriting ? IM_COL32(160, 90, 255, 255) : IM_COL32(0, 102, 255, 255);
+		drawList->AddRectFilled(ImVec2(x0, y1 - height), ImVec2(x1, y1), color);
+
+		float merged = run.values > 0 ? (float)run.merged / run.values : 0.0f;
+		drawList->AddRectFilled(ImVec2(x0, y1 - height * merged), ImVec2(x1, y1), IM_COL32(0, 200, 100, 255));
+		i++;
+	}
+}
+
+void RenderExternalSort() {
+	static char inputPath[260] = "external_input.bin";
+	static char outputPath[260] = "external_sorted.bin";
+	static int generateMB = 256;
+	static int memoryMB = 64;
+	static int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+	static const char* phaseNames[] = { "Idle", "Generating input", "Forming runs", "Merging", "Verifying", "Done", "Failed" };
+
+	ImGui::InputText("Input File (raw int32)", inputPath, sizeof(inputPath));
+	ImGui::InputText("Output File", outputPath, sizeof(outputPath));
+	ImGui::InputInt("Generate size (MB)", &generateMB, 64, 1024);
+	ImGui::InputInt("Memory budget (MB)", &memoryMB, 16, 256);
+	ImGui::SliderInt("Threads", &threads, 1, 64);
+
+	if (!externalSort.running) {
+		if (ImGui::Button("Generate Input File")) {
+			startExternalSort(inputPath, outputPath, memoryMB, threads, (long long)std::max(1, generateMB) * (1 << 20) / (long long)sizeof(int));
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Sort File")) {
+			startExternalSort(inputPath, outputPath, memoryMB, threads, 0);
+		}
+	}
+	else if (ImGui::Button("Cancel")) {
+		externalSort.cancel = true;
+	}
+
+	int phase = externalSort.phase;
+	ImGui::Text("Phase: %s", phaseNames[phase]);
+	if (externalSort.running) {
+		double seconds, mbps;
+		externalPhaseStats(seconds, mbps);
+		float fraction = 0.0f;
+		if (phase == PhaseGenerating) fraction = (float)externalSort.bytesWritten / (externalSort.generateValues * sizeof(int));
+		else if (phase == PhaseForming && externalSort.inputBytes > 0) fraction = (float)externalSort.bytesRead / externalSort.inputBytes;
+		// Every merge pass writes all values once
+		else if (phase == PhaseMerging && externalSort.totalValues > 0 && externalSort.mergePasses > 0) {
+			fraction = (float)externalSort.bytesWritten / (externalSort.totalValues * sizeof(int) * externalSort.mergePasses);
+		}
+		else if (phase == PhaseVerifying && externalSort.totalValues > 0) fraction = (float)externalSort.bytesRead / (externalSort.totalValues * sizeof(int));
+		ImGui::ProgressBar(std::min(1.0f, fraction));
+		ImGui::Text("I/O: %.1f MB/s (%.1f s)", mbps, seconds);
+		if (phase == PhaseMerging) ImGui::Text("Merge pass %d of %d", (int)externalSort.mergePass, (int)externalSort.mergePasses);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(externalSort.mutex);
+		if (!externalSort.error.empty()) {
+			ImGui::TextWrapped("%s", externalSort.error.c_str());
+		}
+		ImGui::Text("%zu runs, %lld values", externalSort.runs.size(), (long long)externalSort.totalValues);
+		if (externalSort.formSeconds > 0.0) {
+			ImGui::Text("Run formation: %.2f s, %.1f MB/s", externalSort.formSeconds, externalSort.formMBps);
+		}
+		if (externalSort.mergeSeconds > 0.0) {
+			ImGui::Text("Merge: %.2f s, %.1f MB/s, %d pass(es)%s", externalSort.mergeSeconds, externalSort.mergeMBps,
+				(int)externalSort.mergePass, externalSort.verified ? ", output verified sorted" : "");
+		}
+	}
+
+	ImVec2 canvasPos = ImGui::GetCursorScreenPos();
+	ImVec2 canvasSize = ImGui::GetContentRegionAvail();
+	canvasSize.y = 120; // Fix canvas height
+	ImGui::InvisibleButton("Runs", canvasSize);
+	renderExternalRuns(ImGui::GetWindowDrawList(), canvasPos, canvasSize);
+}
+
+void RenderSorting() {
+	static char userValues[1024] = "";
+	static const char* sortNames[sortAlgorithmCount] = { "Bubble Sort", "Selection Sort", "Insertion Sort", "Merge Sort", "Quick Sort", "Heap Sort" };
+	static const char* elementNames[] = { "int32", "int64", "float", "key-value" };
+	static int benchmarkSize = 10000;
+
+	ImGui::Begin("Sorting");
+
+	// Element type selection (regenerates the data in the new type)
+	int selectedType = elementType;
+	if (ImGui::Combo("Element Type", &selectedType, elementNames, IM_ARRAYSIZE(elementNames)) && !isSorting) {
+		elementType = selectedType;
+		generateRandomData(sortValueCount);
+	}
+
+	// Input controls
+	ImGui::InputInt("Values to generate", &sortValueCount, 1, 100);
+	if (ImGui::Button("Generate Random Data")) {
+		generateRandomData(sortValueCount);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Shuffle Data")) {
+		shuffleData();
+	}
+	ImGui::InputText("Custom Values (space-separated)", userValues, sizeof(userValues));
+	if (ImGui::Button("Set Custom Data") && !isSorting) {
+		AllocScope scope(TagSortData);
+		withSortData(elementType, [](auto& values) {
+			values.clear();
+			char* nextToken = nullptr;
+			char* token = strtok_s(userValues, " ", &nextToken);
+			while (token != nullptr) {
+				values.emplace_back();
+				parseElement(values.back(), token, (int)values.size() - 1);
+				token = strtok_s(nullptr, " ", &nextToken);
+			}
 			});
-		sortingThread.detach();
+	}
+
+	// Sorting algorithm selection
+	ImGui::Combo("Algorithm", &sortAlgorithm, sortNames, IM_ARRAYSIZE(sortNames));
+
+	// Speed control
+	ImGui::SliderInt("Speed (ms)", &sortSpeed, 1, 200);
+
+	// Start sorting
+	if (!isSorting && ImGui::Button("Start Sorting")) {
+		startSorting(sortAlgorithm);
 	}
 
 	// Stop sorting
@@ -548,6 +1966,25 @@ void RenderSorting() {
 		stopSorting();
 	}
 
+	// Benchmark the selected algorithm without visualization
+	ImGui::InputInt("Benchmark size", &benchmarkSize, 1000, 100000);
+	if (!sortBenchmark.running && ImGui::Button("Run Benchmark")) {
+		startSortBenchmark(sortAlgorithm, elementType, benchmarkSize);
+	}
+	if (sortBenchmark.running) {
+		ImGui::Text("Benchmarking %s on %d %s values...", sortNames[sortBenchmark.algorithm], sortBenchmark.size, elementNames[sortBenchmark.type]);
+	}
+	else if (sortBenchmark.outOfMemory) {
+		ImGui::Text("%s, %d %s values: out of memory, try a smaller size", sortNames[sortBenchmark.algorithm],
+			sortBenchmark.size, elementNames[sortBenchmark.type]);
+	}
+	else if (sortBenchmark.size > 0) {
+		ImGui::Text("%s, %d %s values: %.3f ms unobserved (std::sort %.3f ms)%s", sortNames[sortBenchmark.algorithm],
+			sortBenchmark.size, elementNames[sortBenchmark.type], sortBenchmark.unobservedMs, sortBenchmark.stdSortMs,
+			sortBenchmark.sorted ? "" : " NOT SORTED");
+		ImGui::Text("%lld comparisons, %lld element moves", sortBenchmark.comparisons, sortBenchmark.moves);
+	}
+
 	// Visualize data
 	ImGui::Text("Data Visualization:");
 	ImGui::Separator();
@@ -558,7 +1995,15 @@ void RenderSorting() {
 	ImDrawList* drawList = ImGui::GetWindowDrawList();
 
 	// Render data bars
-	renderDataBars(drawList, canvasPos, canvasSize);
+	withSortData(elementType, [&](const auto& values) { renderDataBars(values, drawList, canvasPos, canvasSize); });
+	if (elementType == ElementKeyValue && !isSorting && lastSortStable >= 0) {
+		ImGui::Text("%s", lastSortStable ? "Stable: equal keys kept their order" : "Unstable: equal keys were reordered");
+	}
+
+	// Sorting files that don't fit in memory
+	if (ImGui::CollapsingHeader("External Sort")) {
+		RenderExternalSort();
+	}
 
 	ImGui::End();
 }
@@ -568,6 +2013,7 @@ void RenderSorting() {
 class Stack {
 public:
 	void Push(int value) {
+		DefaultAllocScope scope(TagStack);
 		data.push_back(value);
 	}
 
@@ -577,6 +2023,24 @@ public:
 		}
 	}
 
+	// Batch operations
+	void PushMany(const int* values, size_t n) {
+		DefaultAllocScope scope(TagStack);
+		data.insert(data.end(), values, values + n);
+	}
+
+	void PopMany(size_t n) {
+		data.resize(data.size() > n ? data.size() - n : 0);
+	}
+
+	void Clear() {
+		data.clear();
+	}
+
+	void Swap(Stack& other) {
+		data.swap(other.data);
+	}
+
 	const std::vector<int>& GetData() const {
 		return data;
 	}
@@ -597,11 +2061,15 @@ void RenderStackUI(Stack& stack) {
 	// Input field for custom values to push to stack
 	ImGui::InputInt("Enter Value to Push", &inputValue);
 
-	if (ImGui::Button("Push")) {
+	bool locked = batchScriptRunning();
+	if (locked) {
+		ImGui::Text("Batch script running...");
+	}
+	else if (ImGui::Button("Push")) {
 		stack.Push(inputValue);
 	}
 
-	if (ImGui::Button("Pop") && !stack.GetData().empty() && !isPopping) {
+	if (!locked && ImGui::Button("Pop") && !stack.GetData().empty() && !isPopping) {
 		// Start animation for pop
 		isPopping = true;
 		popAnimTime = 0.0f;
@@ -626,10 +2094,15 @@ void RenderStackUI(Stack& stack) {
 		}
 	}
 
-	// Render elements in the stack
+	// Render elements in the stack (only the topmost ones for very large stacks)
+	const size_t maxVisibleElements = 32;
+	size_t firstVisible = stack.GetData().size() > maxVisibleElements ? stack.GetData().size() - maxVisibleElements : 0;
+	if (firstVisible > 0) {
+		ImGui::Text("... %zu elements below", firstVisible);
+	}
 	ImDrawList* draw_list = ImGui::GetWindowDrawList();
-	for (int i = 0; i < stack.GetData().size(); ++i) {
-		float yOffset = stackPosition.y + (i * elementHeight);
+	for (size_t i = firstVisible; i < stack.GetData().size(); ++i) {
+		float yOffset = stackPosition.y + ((i - firstVisible) * elementHeight);
 		if (isPopping && i == stack.GetData().size() - 1) {
 			// Animate the pop element
 			float alpha = 1.0f - (popAnimTime / popAnimDuration);
@@ -642,7 +2115,8 @@ void RenderStackUI(Stack& stack) {
 
 		// Display stack value as text
 		ImVec2 textPos(stackPosition.x + 10, yOffset + (elementHeight / 2) - 10);
-		draw_list->AddText(textPos, IM_COL32(255, 255, 255, 255), std::to_string(stack.GetData()[i]).c_str());
+		const IntLabel& label = intLabels.get(stack.GetData()[i]);
+		draw_list->AddText(textPos, IM_COL32(255, 255, 255, 255), label.text, label.text + label.length);
 	}
 
 	ImGui::Text("Number of elements: %d", stack.GetData().size());
@@ -653,27 +2127,49 @@ void RenderStackUI(Stack& stack) {
 
 class Queue {
 private:
-	std::queue<int> q;
+	std::deque<int> q;
 
 public:
 	void enqueue(int value) {
-		q.push(value);
+		DefaultAllocScope scope(TagQueue);
+		q.push_back(value);
 	}
 
 	void dequeue() {
 		if (!q.empty()) {
-			q.pop();
+			q.pop_front();
 		}
 	}
 
+	// Batch operations
+	void enqueueMany(const int* values, size_t n) {
+		DefaultAllocScope scope(TagQueue);
+		q.insert(q.end(), values, values + n);
+	}
+
+	void dequeueMany(size_t n) {
+		q.erase(q.begin(), q.begin() + std::min(n, q.size()));
+	}
+
+	void clear() {
+		q.clear();
+	}
+
+	void swap(Queue& other) {
+		q.swap(other.q);
+	}
+
+	size_t size() const {
+		return q.size();
+	}
+
+	// Front-to-rear access without copying the whole queue
+	int at(size_t index) const {
+		return q[index];
+	}
+
 	std::vector<int> toVector() {
-		std::vector<int> result;
-		std::queue<int> temp = q;
-		while (!temp.empty()) {
-			result.push_back(temp.front());
-			temp.pop();
-		}
-		return result;
+		return std::vector<int>(q.begin(), q.end());
 	}
 
 	bool isEmpty() {
@@ -681,110 +2177,934 @@ public:
 	}
 };
 
-// Draw a 2D rectangle with gradient (for pseudo-3D effect)
-void Draw3DRectangle(ImDrawList* drawList, float x, float y, float width, float height, ImU32 color1, ImU32 color2, ImU32 shadowColor) {
-	// Shadow for depth
-	drawList->AddRectFilled(ImVec2(x + 5, y + 5), ImVec2(x + width + 5, y + height + 5), shadowColor);
-
-	// Gradient for pseudo-3D look
-	drawList->AddRectFilledMultiColor(ImVec2(x, y), ImVec2(x + width, y + height), color1, color1, color2, color2);
-	// Border
-	drawList->AddRect(ImVec2(x, y), ImVec2(x + width, y + height), IM_COL32(0, 0, 0, 255));
-}
-
-// Draw text in the center of a rectangle
-void DrawTextInRectangle(ImDrawList* drawList, float x, float y, float width, float height, const std::string& text, ImU32 textColor) {
-	ImVec2 textSize = ImGui::CalcTextSize(text.c_str());
-	drawList->AddText(ImVec2(x + (width - textSize.x) / 2, y + (height - textSize.y) / 2), textColor, text.c_str());
+// Streaming Ingestion
+//
+// Feeds the queue from a file, a named pipe or a local (Unix domain) socket at
+// full speed. Values are integers separated by anything else. A reader thread
+// parses the input in blocks into a bounded queue and a consumer thread takes
+// values off the front at a set rate; when the queue is full the backpressure
+// policy makes the reader wait, evicts the oldest values or drops the incoming
+// ones. The queue belongs to the stream while it runs and the view draws a
+// snapshot of its front taken under a short lock.
+
+enum IngestSource { SourceFile, SourcePipe, SourceSocket };
+enum BackpressurePolicy { BackpressureBlock, BackpressureDropOldest, BackpressureDropNewest };
+
+#ifdef _WIN32
+typedef SOCKET SocketHandle;
+const SocketHandle invalidSocket = INVALID_SOCKET;
+void closeSocket(SocketHandle s) { closesocket(s); }
+#else
+typedef int SocketHandle;
+const SocketHandle invalidSocket = -1;
+void closeSocket(SocketHandle s) { ::close(s); }
+#endif
+
+// Waits up to timeoutMs for s to become readable
+bool waitReadable(SocketHandle s, int timeoutMs) {
+	fd_set readable;
+	FD_ZERO(&readable);
+	FD_SET(s, &readable);
+	timeval timeout = { 0, timeoutMs * 1000 };
+	return select((int)s + 1, &readable, nullptr, nullptr, &timeout) > 0;
 }
 
-// Function to visualize the queue graphically
-void RenderQueue(Queue& queue) {
-	static int inputValue = 0;
-	static std::string message = "";
-
-	// Create a new ImGui window for the queue visualizer
-	ImGui::Begin("Queue");
-
-	// Input for new element
-	ImGui::InputInt("Value to Enqueue", &inputValue);
+// Byte source for the reader. read() waits at most ~100 ms so cancellation is
+// noticed; it returns the number of bytes read, 0 if none arrived yet, or -1 at
+// the end of the stream. A socket source listens on its path and reads from the
+// first producer that connects.
+class IngestStream {
+public:
+	~IngestStream() { close(); }
+
+	bool open(int kind, const std::string& path, std::string& error) {
+		source = kind;
+		if (source == SourceSocket) return listenOn(path, error);
+#ifdef _WIN32
+		if (source == SourcePipe) {
+			// Named pipes are opened as \\.\pipe\name clients and polled with
+			// PeekNamedPipe, since a plain read would block until the buffer fills
+			pipe = CreateFileA(path.c_str(), GENERIC_READ, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+			if (pipe == INVALID_HANDLE_VALUE) error = "Could not open " + path + ".";
+			return pipe != INVALID_HANDLE_VALUE;
+		}
+		file = std::fopen(path.c_str(), "rb");
+		if (!file) error = "Could not open " + path + ".";
+		return file != nullptr;
+#else
+		// Non-blocking so opening a FIFO doesn't wait for a writer
+		fd = ::open(path.c_str(), O_RDONLY | (source == SourcePipe ? O_NONBLOCK : 0));
+		if (fd < 0) error = "Could not open " + path + ".";
+		return fd >= 0;
+#endif
+	}
 
-	// Enqueue button
-	if (ImGui::Button("Enqueue")) {
-		queue.enqueue(inputValue);
-		message = "Enqueued " + std::to_string(inputValue) + ".";
+	long read(char* buffer, size_t n) {
+		if (source == SourceSocket) return readSocket(buffer, n);
+#ifdef _WIN32
+		if (source == SourcePipe) return readPipe(buffer, n);
+		size_t got = std::fread(buffer, 1, n, file);
+		return got > 0 ? (long)got : -1;
+#else
+		if (source == SourcePipe && !waitReadable(fd, 100)) return 0;
+		ssize_t got = ::read(fd, buffer, n);
+		if (got > 0) {
+			sawData = true;
+			return (long)got;
+		}
+		if (got < 0 && (errno == EAGAIN || errno == EINTR)) return 0;
+		if (got == 0 && source == SourcePipe && !sawData) {
+			// No writer has sent anything yet
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			return 0;
+		}
+		return -1;
+#endif
 	}
 
-	ImGui::SameLine();
+	void close() {
+		if (connection != invalidSocket) closeSocket(connection);
+		if (listener != invalidSocket) closeSocket(listener);
+		connection = listener = invalidSocket;
+		if (!socketPath.empty()) std::remove(socketPath.c_str());
+		socketPath.clear();
+#ifdef _WIN32
+		if (file) std::fclose(file);
+		file = nullptr;
+		if (pipe != INVALID_HANDLE_VALUE) CloseHandle(pipe);
+		pipe = INVALID_HANDLE_VALUE;
+#else
+		if (fd >= 0) ::close(fd);
+		fd = -1;
+#endif
+	}
 
-	// Dequeue button
-	if (ImGui::Button("Dequeue")) {
-		if (!queue.isEmpty()) {
-			queue.dequeue();
-			message = "Dequeued an element.";
+private:
+	bool listenOn(const std::string& path, std::string& error) {
+#ifdef _WIN32
+		static bool started = false;
+		if (!started) {
+			WSADATA wsa;
+			started = WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
 		}
-		else {
-			message = "Queue is empty! Cannot dequeue.";
+#else
+		// Replace a socket left behind by an earlier run, but never any other file
+		struct stat info;
+		if (stat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) unlink(path.c_str());
+#endif
+		sockaddr_un address = {};
+		if (path.size() >= sizeof(address.sun_path)) {
+			error = "Socket path is too long.";
+			return false;
+		}
+		address.sun_family = AF_UNIX;
+		std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+		listener = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener == invalidSocket || bind(listener, (sockaddr*)&address, sizeof(address)) != 0) {
+			error = "Could not bind a socket to " + path + ".";
+			return false;
 		}
+		socketPath = path;
+		if (listen(listener, 1) != 0) {
+			error = "Could not listen on " + path + ".";
+			return false;
+		}
+		return true;
 	}
 
-	// Display the message
-	if (!message.empty()) {
-		ImGui::Text("%s", message.c_str());
+#ifdef _WIN32
+	// Reads whatever the pipe holds, waiting up to ~100 ms for something to arrive
+	long readPipe(char* buffer, size_t n) {
+		DWORD available = 0;
+		for (int wait = 0; wait < 10; ++wait) {
+			if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &available, nullptr)) return -1; // Writer closed its end
+			if (available > 0) break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		if (available == 0) return 0;
+		DWORD got = 0;
+		if (!ReadFile(pipe, buffer, (DWORD)std::min<size_t>(n, available), &got, nullptr)) return -1;
+		return (long)got;
 	}
+#endif
 
-	// Get the current window's drawing list and position
-	ImDrawList* drawList = ImGui::GetWindowDrawList();
-	ImVec2 windowPos = ImGui::GetWindowPos(); // Top-left corner of the window
-	ImVec2 cursorPos = ImGui::GetCursorScreenPos(); // Cursor's position inside the window
+	long readSocket(char* buffer, size_t n) {
+		if (connection == invalidSocket) {
+			// Wait for a producer to connect
+			if (waitReadable(listener, 100)) connection = accept(listener, nullptr, nullptr);
+			return 0;
+		}
+		if (!waitReadable(connection, 100)) return 0;
+		int got = (int)recv(connection, buffer, (int)std::min(n, (size_t)INT_MAX), 0);
+		return got > 0 ? got : -1;
+	}
 
-	// Set up drawing coordinates relative to the window
-	float x = cursorPos.x;
-	float y = cursorPos.y + 50; // Start slightly below the cursor position
-	float width = 100.0f, height = 60.0f;
-	float xOffset = 110.0f;
+	int source = SourceFile;
+	SocketHandle listener = invalidSocket;
+	SocketHandle connection = invalidSocket;
+	std::string socketPath;  // Removed on close since this stream created it
+#ifdef _WIN32
+	std::FILE* file = nullptr;
+	HANDLE pipe = INVALID_HANDLE_VALUE;
+#else
+	int fd = -1;
+	bool sawData = false;
+#endif
+};
 
-	ImU32 baseColor1 = IM_COL32(100, 200, 255, 255);  // Top gradient color
-	ImU32 baseColor2 = IM_COL32(50, 150, 200, 255);   // Bottom gradient color
-	ImU32 shadowColor = IM_COL32(0, 0, 0, 80);        // Shadow color
-	ImU32 textColor = IM_COL32(255, 255, 255, 255);   // Text color
+// Parses integers out of input that arrives in arbitrary blocks; a number cut off
+// at the end of a block carries over into the next one. Out-of-range values clamp.
+struct IntStreamParser {
+	long long value = 0;
+	bool negative = false;
+	bool inNumber = false;
+
+	template <typename Emit>
+	void parse(const char* bytes, size_t n, Emit& emit) {
+		for (size_t i = 0; i < n; ++i) {
+			char c = bytes[i];
+			if (c >= '0' && c <= '9') {
+				if (value <= INT_MAX) value = value * 10 + (c - '0');
+				inNumber = true;
+			}
+			else {
+				flush(emit);
+				negative = c == '-';
+			}
+		}
+	}
 
-	// Draw the queue elements graphically
-	std::vector<int> elements = queue.toVector();
-	for (int i = 0; i < elements.size(); i++) {
-		// Draw each node with a 3D-like effect
+	// Emits the number in progress, if any
+	template <typename Emit>
+	void flush(Emit& emit) {
+		if (inNumber) {
+			long long v = negative ? -value : value;
+			emit((int)std::max<long long>(INT_MIN, std::min<long long>(INT_MAX, v)));
+		}
+		value = 0;
+		negative = false;
+		inNumber = false;
+	}
+};
+
+struct IngestJob {
+	// Settings, fixed while the stream runs
+	std::string path;
+	int source = SourceFile;
+	int policy = BackpressureBlock;
+	size_t capacity = 100000;
+	std::atomic<int> consumeRate{ 0 }; // Values per second taken off the front; 0 pauses the consumer
+
+	std::thread reader, consumer;
+	std::atomic<bool> running{ false };
+	std::atomic<bool> cancel{ false };
+	std::atomic<bool> readerDone{ false };
+	std::atomic<long long> ingested{ 0 };      // Values taken off the source
+	std::atomic<long long> dropped{ 0 };       // Values rejected or evicted by the policy
+	std::atomic<long long> consumed{ 0 };
+	std::atomic<long long> bytesRead{ 0 };
+	std::atomic<long long> blockedMicros{ 0 }; // Time the reader spent waiting for space
+
+	std::mutex mutex; // Guards queue and error
+	std::condition_variable notFull;
+	Queue queue;
+	std::string error;
+};
+IngestJob ingestJob;
+
+// Moves parsed values into the queue, applying the backpressure policy when it's full
+void ingestValues(const int* values, size_t n) {
+	AllocScope scope(TagQueue); // The stream fills the queue the view shows
+	std::unique_lock<std::mutex> lock(ingestJob.mutex);
+	Queue& queue = ingestJob.queue;
+	size_t capacity = ingestJob.capacity;
+	if (ingestJob.policy == BackpressureBlock) {
+		while (n > 0 && !ingestJob.cancel) {
+			if (queue.size() >= capacity) {
+				long long start = steadyMicros();
+				ingestJob.notFull.wait(lock, [&]() { return queue.size() < capacity || ingestJob.cancel; });
+				ingestJob.blockedMicros += steadyMicros() - start;
+				continue;
+			}
+			size_t take = std::min(n, capacity - queue.size());
+			queue.enqueueMany(values, take);
+			ingestJob.ingested += take;
+			values += take;
+			n -= take;
+		}
+	}
+	else if (ingestJob.policy == BackpressureDropNewest) {
+		size_t take = std::min(n, capacity - std::min(capacity, queue.size()));
+		queue.enqueueMany(values, take);
+		ingestJob.ingested += n;
+		ingestJob.dropped += n - take;
+	}
+	else {
+		// Only the newest capacity values can survive
+		ingestJob.ingested += n;
+		if (n > capacity) {
+			ingestJob.dropped += n - capacity;
+			values += n - capacity;
+			n = capacity;
+		}
+		size_t overflow = queue.size() + n > capacity ? queue.size() + n - capacity : 0;
+		queue.dequeueMany(overflow);
+		ingestJob.dropped += overflow;
+		queue.enqueueMany(values, n);
+	}
+}
+
+void runIngestReader() {
+	AllocScope scope(TagIngest);
+	IngestStream stream;
+	std::string error;
+	if (!stream.open(ingestJob.source, ingestJob.path, error)) {
+		std::lock_guard<std::mutex> lock(ingestJob.mutex);
+		ingestJob.error = error;
+		ingestJob.readerDone = true;
+		return;
+	}
+
+	// A block of n bytes holds at most n / 2 + 1 numbers
+	std::vector<char> block(1 << 16);
+	std::vector<int> values;
+	values.reserve(block.size() / 2 + 1);
+	IntStreamParser parser;
+	auto emit = [&values](int value) { values.push_back(value); };
+	while (!ingestJob.cancel) {
+		long got = stream.read(block.data(), block.size());
+		if (got < 0) break;
+		ingestJob.bytesRead += got;
+		parser.parse(block.data(), (size_t)got, emit);
+		if (!values.empty()) {
+			ingestValues(values.data(), values.size());
+			values.clear();
+		}
+	}
+	parser.flush(emit); // Input may end without a separator
+	if (!values.empty() && !ingestJob.cancel) ingestValues(values.data(), values.size());
+	ingestJob.readerDone = true;
+}
+
+// Takes values off the front at consumeRate per second, waking every few milliseconds
+void runIngestConsumer() {
+	double budget = 0.0;
+	long long last = steadyMicros();
+	while (!ingestJob.cancel) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		long long now = steadyMicros();
+		int rate = ingestJob.consumeRate;
+		// Carry at most 100 ms of unused budget so an empty queue doesn't bank a burst
+		budget = std::min(budget + (now - last) * 1e-6 * rate, rate * 0.1 + 1.0);
+		last = now;
+		size_t take = (size_t)budget;
+		if (take == 0) continue;
+		{
+			std::lock_guard<std::mutex> lock(ingestJob.mutex);
+			take = std::min(take, ingestJob.queue.size());
+			ingestJob.queue.dequeueMany(take);
+		}
+		budget -= take;
+		ingestJob.consumed += take;
+		ingestJob.notFull.notify_all();
+	}
+}
+
+// Starts streaming into queue. Its contents move to the stream (and stay subject
+// to capacity and the consumer) until stopIngest hands them back.
+void startIngest(const std::string& path, int source, int policy, size_t capacity, int consumeRate, Queue& queue) {
+	if (ingestJob.running) return;
+	ingestJob.path = path;
+	ingestJob.source = source;
+	ingestJob.policy = policy;
+	ingestJob.capacity = std::max<size_t>(1, capacity);
+	ingestJob.consumeRate = consumeRate;
+	ingestJob.cancel = false;
+	ingestJob.readerDone = false;
+	ingestJob.ingested = 0;
+	ingestJob.dropped = 0;
+	ingestJob.consumed = 0;
+	ingestJob.bytesRead = 0;
+	ingestJob.blockedMicros = 0;
+	ingestJob.error.clear();
+	ingestJob.queue.clear();
+	ingestJob.queue.swap(queue);
+	ingestJob.running = true;
+	ingestJob.reader = std::thread(runIngestReader);
+	ingestJob.consumer = std::thread(runIngestConsumer);
+}
+
+// Stops both threads and hands the queue back to the view
+void stopIngest(Queue& queue) {
+	if (!ingestJob.running) return;
+	{
+		// Under the lock so a reader about to wait for space can't miss the wakeup
+		std::lock_guard<std::mutex> lock(ingestJob.mutex);
+		ingestJob.cancel = true;
+	}
+	ingestJob.notFull.notify_all();
+	ingestJob.reader.join();
+	ingestJob.consumer.join();
+	ingestJob.queue.swap(queue);
+	ingestJob.queue.clear();
+	ingestJob.running = false;
+}
+
+void RenderIngest(Queue& queue, size_t depth) {
+	static char path[260] = "values.txt";
+	static int source = SourceFile;
+	static int policy = BackpressureBlock;
+	static int capacity = 100000;
+	static int consumeRate = 100000;
+	static const char* sourceNames[] = { "File", "Named pipe", "Unix socket" };
+	static const char* policyNames[] = { "Block reader", "Drop oldest", "Drop newest" };
+	static long long lastIngested = 0, lastConsumed = 0;
+	static float ingestRate = 0.0f, consumedRate = 0.0f;
+	static double sampleTime = 0.0, lastSample = 0.0;
+
+	ImGui::Combo("Source", &source, sourceNames, IM_ARRAYSIZE(sourceNames));
+	ImGui::InputText("Path", path, sizeof(path));
+	ImGui::Combo("When full", &policy, policyNames, IM_ARRAYSIZE(policyNames));
+	ImGui::InputInt("Capacity", &capacity, 1000, 100000);
+	ImGui::InputInt("Consume per second", &consumeRate, 1000, 100000);
+	consumeRate = std::max(0, consumeRate);
+	ingestJob.consumeRate = consumeRate;
+
+	if (!ingestJob.running) {
+		if (batchScriptRunning()) {
+			ImGui::Text("Wait for the batch script before streaming.");
+		}
+		else if (ImGui::Button("Start Stream")) {
+			startIngest(path, source, policy, (size_t)std::max(1, capacity), consumeRate, queue);
+			lastIngested = lastConsumed = 0;
+			ingestRate = consumedRate = 0.0f;
+		}
+		return;
+	}
+	if (ImGui::Button("Stop Stream")) {
+		stopIngest(queue);
+		return;
+	}
+
+	// Refresh rates twice a second
+	sampleTime += ImGui::GetIO().DeltaTime;
+	if (sampleTime - lastSample >= 0.5) {
+		long long ingested = ingestJob.ingested, consumed = ingestJob.consumed;
+		ingestRate = (float)((ingested - lastIngested) / (sampleTime - lastSample));
+		consumedRate = (float)((consumed - lastConsumed) / (sampleTime - lastSample));
+		lastIngested = ingested;
+		lastConsumed = consumed;
+		lastSample = sampleTime;
+	}
+
+	char overlay[64];
+	std::snprintf(overlay, sizeof(overlay), "%zu / %zu", depth, ingestJob.capacity);
+	ImGui::ProgressBar(std::min(1.0f, (float)depth / ingestJob.capacity), ImVec2(-1, 0), overlay);
+	long long ingested = ingestJob.ingested, dropped = ingestJob.dropped;
+	ImGui::Text("Ingest: %.0f values/s, consume: %.0f values/s", ingestRate, consumedRate);
+	ImGui::Text("Ingested %lld, dropped %lld (%.1f%%), consumed %lld", ingested, dropped,
+		ingested > 0 ? 100.0 * dropped / ingested : 0.0, (long long)ingestJob.consumed);
+	if (ingestJob.policy == BackpressureBlock) {
+		ImGui::Text("Reader blocked for %.2f s", ingestJob.blockedMicros * 1e-6);
+	}
+	if (ingestJob.readerDone) {
+		std::lock_guard<std::mutex> lock(ingestJob.mutex);
+		ImGui::TextWrapped("%s", ingestJob.error.empty() ? "Source ended." : ingestJob.error.c_str());
+	}
+}
+
+// Draw a 2D rectangle with gradient (for pseudo-3D effect)
+void Draw3DRectangle(ImDrawList* drawList, float x, float y, float width, float height, ImU32 color1, ImU32 color2, ImU32 shadowColor) {
+	// Shadow for depth
+	drawList->AddRectFilled(ImVec2(x + 5, y + 5), ImVec2(x + width + 5, y + height + 5), shadowColor);
+
+	// Gradient for pseudo-3D look
+	drawList->AddRectFilledMultiColor(ImVec2(x, y), ImVec2(x + width, y + height), color1, color1, color2, color2);
+	// Border
+	drawList->AddRect(ImVec2(x, y), ImVec2(x + width, y + height), IM_COL32(0, 0, 0, 255));
+}
+
+// Draw a cached label in the center of a rectangle
+void DrawTextInRectangle(ImDrawList* drawList, float x, float y, float width, float height, const IntLabel& label, ImU32 textColor) {
+	drawList->AddText(ImVec2(x + (width - label.size.x) / 2, y + (height - label.size.y) / 2), textColor, label.text, label.text + label.length);
+}
+
+// Function to visualize the queue graphically
+void RenderQueue(Queue& queue) {
+	static int inputValue = 0;
+	static std::string message = "";
+
+	// While streaming the queue belongs to the ingest threads, so draw a snapshot
+	// of its front taken under their lock
+	const size_t maxVisibleElements = 32;
+	int front[maxVisibleElements];
+	size_t total, visible;
+	{
+		std::lock_guard<std::mutex> lock(ingestJob.mutex);
+		const Queue& shown = ingestJob.running ? ingestJob.queue : queue;
+		total = shown.size();
+		visible = std::min(total, maxVisibleElements);
+		for (size_t i = 0; i < visible; i++) front[i] = shown.at(i);
+	}
+
+	// Create a new ImGui window for the queue visualizer
+	ImGui::Begin("Queue");
+
+	// Input for new element
+	ImGui::InputInt("Value to Enqueue", &inputValue);
+
+	// Enqueue button
+	bool locked = ingestJob.running || batchScriptRunning();
+	if (ingestJob.running) {
+		ImGui::Text("Streaming from %s...", ingestJob.path.c_str());
+	}
+	else if (locked) {
+		ImGui::Text("Batch script running...");
+	}
+	else if (ImGui::Button("Enqueue")) {
+		queue.enqueue(inputValue);
+		message = "Enqueued " + std::to_string(inputValue) + ".";
+	}
+
+	ImGui::SameLine();
+
+	// Dequeue button
+	if (!locked && ImGui::Button("Dequeue")) {
+		if (!queue.isEmpty()) {
+			queue.dequeue();
+			message = "Dequeued an element.";
+		}
+		else {
+			message = "Queue is empty! Cannot dequeue.";
+		}
+	}
+
+	// Display the message
+	if (!message.empty()) {
+		ImGui::Text("%s", message.c_str());
+	}
+
+	if (ImGui::CollapsingHeader("Live Ingestion")) {
+		RenderIngest(queue, total);
+	}
+
+	// Get the current window's drawing list and position
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	ImVec2 windowPos = ImGui::GetWindowPos(); // Top-left corner of the window
+	ImVec2 cursorPos = ImGui::GetCursorScreenPos(); // Cursor's position inside the window
+
+	// Set up drawing coordinates relative to the window
+	float x = cursorPos.x;
+	float y = cursorPos.y + 50; // Start slightly below the cursor position
+	float width = 100.0f, height = 60.0f;
+	float xOffset = 110.0f;
+
+	ImU32 baseColor1 = IM_COL32(100, 200, 255, 255);  // Top gradient color
+	ImU32 baseColor2 = IM_COL32(50, 150, 200, 255);   // Bottom gradient color
+	ImU32 shadowColor = IM_COL32(0, 0, 0, 80);        // Shadow color
+	ImU32 textColor = IM_COL32(255, 255, 255, 255);   // Text color
+
+	// Draw the queue elements graphically (only the front of very large queues)
+	for (size_t i = 0; i < visible; i++) {
+		// Draw each node with a 3D-like effect
 		Draw3DRectangle(drawList, x, y, width, height, baseColor1, baseColor2, shadowColor);
 
 		// Draw the value inside the rectangle
-		DrawTextInRectangle(drawList, x, y, width, height, std::to_string(elements[i]), textColor);
+		DrawTextInRectangle(drawList, x, y, width, height, intLabels.get(front[i]), textColor);
 
 		x += xOffset; // Move to the next position
 	}
 
 	// Add "Front" and "Rear" labels
-	if (!elements.empty()) {
+	if (visible > 0) {
 		drawList->AddText(ImVec2(cursorPos.x, y + height + 10.0f), textColor, "Front");
-		drawList->AddText(ImVec2(x - xOffset, y + height + 10.0f), textColor, "Rear");
+		if (visible == total) {
+			drawList->AddText(ImVec2(x - xOffset, y + height + 10.0f), textColor, "Rear");
+		}
+		else {
+			ImGui::Text("Showing the first %zu of %zu elements", visible, total);
+		}
 	}
 
 	ImGui::End();
 }
 
-// Main Application
-int main() {
-	// Initialize GLFW and OpenGL
-	if (!glfwInit()) return -1;
-	const char* glsl_version = "#version 130";
-	GLFWwindow* window = glfwCreateWindow(1280, 720, "Cenceptualization of DS", NULL, NULL);
-	if (!window) return -1;
-	glfwMakeContextCurrent(window);
-	glfwSwapInterval(1);
+// Batch Operations and Scripted Streams
+//
+// A script is a list of statements separated by ';' or newlines ('#' starts a comment):
+//   push <values>            Stack push
+//   pop [count]              Stack pop
+//   enqueue <values>         Queue enqueue
+//   dequeue [count]          Queue dequeue
+//   insertFront <values>     Linked list insert at beginning
+//   insertEnd <values>       Linked list insert at end
+//   insertAt <value> <pos>   Linked list insert at position
+//   deleteAt <pos> [count]   Linked list delete at position
+//   clear [list|stack|queue] Clear one structure (or all of them)
+// <values> is a number or an inclusive range "a..b". Numbers accept exponents,
+// so "push 1..1e6; pop 5e5; insertAt 42 1000" is a valid script.
+
+enum BatchOpType { OpPush, OpPop, OpEnqueue, OpDequeue, OpInsertFront, OpInsertEnd, OpInsertAt, OpDeleteAt, OpClear };
+
+struct BatchOp {
+	BatchOpType type;
+	long long first;   // First value of the range, value for insertAt, position for deleteAt
+	long long last;    // Last value of the range
+	long long count;   // Number of operations this statement performs
+	long long position;
+	std::string text;  // Statement as written, for the report
+};
 
-	// Initialize ImGui
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGui_ImplGlfw_InitForOpenGL(window, true);
-	ImGui_ImplOpenGL3_Init(glsl_version);
+struct BatchStepReport {
+	std::string text;
+	long long operations;
+	double milliseconds;
+};
+
+// The structures a script runs against
+struct BatchStructures {
+	LinkedList list;
+	Stack stack;
+	Queue queue;
+};
+
+// Parses "42", "1e6" or "-7" into an integer
+bool parseScriptNumber(const std::string& token, long long& out) {
+	if (token.empty()) return false;
+	char* end = nullptr;
+	double value = std::strtod(token.c_str(), &end);
+	if (*end != '\0' || value != std::floor(value)) return false;
+	if (value < -2147483648.0 || value > 2147483647.0) return false;
+	out = static_cast<long long>(value);
+	return true;
+}
+
+// Parses "a..b" or a single number
+bool parseScriptRange(const std::string& token, long long& first, long long& last) {
+	size_t dots = token.find("..");
+	if (dots == std::string::npos) {
+		if (!parseScriptNumber(token, first)) return false;
+		last = first;
+		return true;
+	}
+	return parseScriptNumber(token.substr(0, dots), first) && parseScriptNumber(token.substr(dots + 2), last);
+}
+
+bool parseBatchStatement(const std::string& statement, BatchOp& op, std::string& error) {
+	std::istringstream in(statement);
+	std::string name, arg1, arg2, extra;
+	in >> name >> arg1 >> arg2 >> extra;
+	std::transform(name.begin(), name.end(), name.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+
+	op.text = statement;
+	op.first = op.last = op.position = 0;
+	op.count = 1;
+	if (!extra.empty()) {
+		error = "Too many arguments in '" + statement + "'";
+		return false;
+	}
+
+	if (name == "push" || name == "enqueue" || name == "insertfront" || name == "insertend") {
+		op.type = name == "push" ? OpPush : name == "enqueue" ? OpEnqueue : name == "insertfront" ? OpInsertFront : OpInsertEnd;
+		if (!arg2.empty() || !parseScriptRange(arg1, op.first, op.last)) {
+			error = "Expected a value or range (a..b) in '" + statement + "'";
+			return false;
+		}
+		op.count = std::llabs(op.last - op.first) + 1;
+		return true;
+	}
+	if (name == "pop" || name == "dequeue") {
+		op.type = name == "pop" ? OpPop : OpDequeue;
+		if (!arg2.empty() || (!arg1.empty() && (!parseScriptNumber(arg1, op.count) || op.count < 0))) {
+			error = "Expected an optional count in '" + statement + "'";
+			return false;
+		}
+		return true;
+	}
+	if (name == "insertat") {
+		op.type = OpInsertAt;
+		if (!parseScriptNumber(arg1, op.first) || !parseScriptNumber(arg2, op.position) || op.position < 0) {
+			error = "Expected 'insertAt <value> <position>' in '" + statement + "'";
+			return false;
+		}
+		return true;
+	}
+	if (name == "deleteat") {
+		op.type = OpDeleteAt;
+		if (!parseScriptNumber(arg1, op.position) || op.position < 0 ||
+			(!arg2.empty() && (!parseScriptNumber(arg2, op.count) || op.count < 0))) {
+			error = "Expected 'deleteAt <position> [count]' in '" + statement + "'";
+			return false;
+		}
+		return true;
+	}
+	if (name == "clear") {
+		op.type = OpClear;
+		if (!arg2.empty() || (!arg1.empty() && arg1 != "list" && arg1 != "stack" && arg1 != "queue")) {
+			error = "Expected 'clear [list|stack|queue]' in '" + statement + "'";
+			return false;
+		}
+		op.position = arg1 == "list" ? 1 : arg1 == "stack" ? 2 : arg1 == "queue" ? 3 : 0;
+		return true;
+	}
+
+	error = "Unknown operation '" + name + "'";
+	return false;
+}
+
+bool parseBatchScript(const std::string& script, std::vector<BatchOp>& ops, std::string& error) {
+	ops.clear();
+	std::istringstream lines(script);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(lines, line)) {
+		lineNumber++;
+		size_t comment = line.find('#');
+		if (comment != std::string::npos) line.erase(comment);
+
+		std::istringstream statements(line);
+		std::string statement;
+		while (std::getline(statements, statement, ';')) {
+			size_t begin = statement.find_first_not_of(" \t\r");
+			if (begin == std::string::npos) continue;
+			statement = statement.substr(begin, statement.find_last_not_of(" \t\r") - begin + 1);
+
+			BatchOp op;
+			if (!parseBatchStatement(statement, op, error)) {
+				error = "Line " + std::to_string(lineNumber) + ": " + error;
+				return false;
+			}
+			ops.push_back(op);
+		}
+	}
+	return true;
+}
+
+// Runs one statement, expanding ranges through a fixed chunk buffer so the
+// structures receive values in bulk. Returns the number of operations performed.
+long long runBatchOp(const BatchOp& op, BatchStructures& s, std::vector<int>& chunk,
+	std::atomic<long long>& progress, const std::atomic<bool>& cancel) {
+	switch (op.type) {
+	case OpPush:
+	case OpEnqueue:
+	case OpInsertFront:
+	case OpInsertEnd: {
+		long long step = op.last >= op.first ? 1 : -1;
+		long long value = op.first;
+		long long remaining = op.count;
+		while (remaining > 0 && !cancel) {
+			size_t n = (size_t)std::min<long long>(remaining, (long long)chunk.size());
+			for (size_t i = 0; i < n; ++i, value += step) {
+				chunk[i] = (int)value;
+			}
+			if (op.type == OpPush) s.stack.PushMany(chunk.data(), n);
+			else if (op.type == OpEnqueue) s.queue.enqueueMany(chunk.data(), n);
+			else if (op.type == OpInsertFront) s.list.insertManyAtBeginning(chunk.data(), n);
+			else s.list.insertManyAtEnd(chunk.data(), n);
+			remaining -= n;
+			progress += n;
+		}
+		return op.count - remaining;
+	}
+	case OpPop: {
+		long long n = std::min<long long>(op.count, s.stack.GetData().size());
+		s.stack.PopMany((size_t)n);
+		progress += op.count;
+		return n;
+	}
+	case OpDequeue: {
+		long long n = std::min<long long>(op.count, s.queue.size());
+		s.queue.dequeueMany((size_t)n);
+		progress += op.count;
+		return n;
+	}
+	case OpInsertAt: {
+		if ((size_t)op.position > s.list.count) return 0; // Position out of bounds
+		s.list.insertAtPosition((int)op.first, (int)op.position);
+		progress += 1;
+		return 1;
+	}
+	case OpDeleteAt: {
+		size_t before = s.list.count;
+		s.list.deleteManyAtPosition((int)op.position, (size_t)op.count);
+		progress += op.count;
+		return (long long)(before - s.list.count);
+	}
+	case OpClear: {
+		if (op.position == 0 || op.position == 1) s.list.clear();
+		if (op.position == 0 || op.position == 2) s.stack.Clear();
+		if (op.position == 0 || op.position == 3) s.queue.clear();
+		progress += 1;
+		return 1;
+	}
+	}
+	return 0;
+}
+
+// Runs a parsed script synchronously, filling one report entry per statement
+void runBatchScript(const std::vector<BatchOp>& ops, BatchStructures& s, std::vector<BatchStepReport>& steps,
+	std::atomic<long long>& progress, const std::atomic<bool>& cancel) {
+	std::vector<int> chunk(64 * 1024);
+	steps.clear();
+	for (const BatchOp& op : ops) {
+		if (cancel) break;
+		auto start = std::chrono::high_resolution_clock::now();
+		long long performed;
+		{
+			// The structures become the views' when collected, so each container
+			// tags its own storage; only the runner's scratch is the script's
+			AllocScope structures(TagOther);
+			performed = runBatchOp(op, s, chunk, progress, cancel);
+		}
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		steps.push_back({ op.text, performed, ms });
+	}
+}
+
+// State of the background script run. The worker owns 'result' until 'finished'
+// is set; the UI thread then swaps it into the structures being rendered.
+struct BatchRun {
+	std::thread worker;
+	std::atomic<bool> running{ false };
+	std::atomic<bool> finished{ false };
+	std::atomic<bool> cancel{ false };
+	std::atomic<long long> progress{ 0 };
+	long long plannedOps = 0;
+	BatchStructures result;
+	std::vector<BatchOp> ops;
+	std::vector<BatchStepReport> steps;
+	double seconds = 0.0;
+};
+BatchRun batchRun;
+
+void startBatchScript(const std::string& script, LinkedList& list, Stack& stack, Queue& queue, bool continueFromCurrent, std::string& error) {
+	if (batchRun.running) return;
+	if (!parseBatchScript(script, batchRun.ops, error)) return;
+	error.clear();
+
+	batchRun.plannedOps = 0;
+	for (const BatchOp& op : batchRun.ops) batchRun.plannedOps += op.count;
+	batchRun.progress = 0;
+	batchRun.cancel = false;
+	batchRun.finished = false;
+	batchRun.running = true;
+
+	// Hand the live structures to the worker so it continues from them; the views
+	// are left with the empty structures collect freed the last result into
+	if (continueFromCurrent) {
+		linkedListSorter.finish();
+		batchRun.result.list.swap(list);
+		batchRun.result.stack.Swap(stack);
+		batchRun.result.queue.swap(queue);
+	}
+
+	batchRun.worker = std::thread([]() {
+		AllocScope scope(TagBatchScript);
+		auto start = std::chrono::high_resolution_clock::now();
+		runBatchScript(batchRun.ops, batchRun.result, batchRun.steps, batchRun.progress, batchRun.cancel);
+		batchRun.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		batchRun.finished = true;
+		});
+}
+
+// Joins a finished (or cancelled) run and hands its structures to the renderer
+void collectBatchScript(LinkedList& list, Stack& stack, Queue& queue) {
+	if (!batchRun.running || !batchRun.finished) return;
+	if (ingestJob.running) return; // The stream owns the queue; collect once it stops
+	batchRun.worker.join();
+	linkedListSorter.finish(); // Don't swap nodes out from under a running sort
+	batchRun.result.list.swap(list);
+	batchRun.result.stack.Swap(stack);
+	batchRun.result.queue.swap(queue);
+
+	// Free the structures the result replaced (swapping releases the stack's and
+	// queue's capacity too), so the next run starts empty
+	batchRun.result.list.clear();
+	Stack().Swap(batchRun.result.stack);
+	Queue().swap(batchRun.result.queue);
+	batchRun.running = false;
+}
+
+bool batchScriptRunning() {
+	return batchRun.running;
+}
+
+void stopBatchScript() {
+	batchRun.cancel = true;
+	if (batchRun.worker.joinable()) {
+		batchRun.worker.join();
+	}
+}
+
+void RenderBatchScript(LinkedList& list, Stack& stack, Queue& queue) {
+	static char script[4096] = "push 1..1e6; pop 5e5\nenqueue 1..1e6; dequeue 250000\ninsertEnd 1..1e6; insertAt 42 1000";
+	static char scriptPath[260] = "";
+	static bool continueFromCurrent = false;
+	static std::string message = "";
+
+	ImGui::Begin("Batch Script");
+
+	ImGui::InputTextMultiline("Script", script, sizeof(script), ImVec2(-1, 120));
+	ImGui::InputText("Script File", scriptPath, sizeof(scriptPath));
+	ImGui::SameLine();
+	if (ImGui::Button("Load")) {
+		std::ifstream file(scriptPath);
+		if (file) {
+			std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			if (contents.size() >= sizeof(script)) {
+				message = "Script file is too large for the editor.";
+			}
+			else {
+				std::copy(contents.begin(), contents.end(), script);
+				script[contents.size()] = '\0';
+				message = "Loaded " + std::string(scriptPath) + ".";
+			}
+		}
+		else {
+			message = "Could not open " + std::string(scriptPath) + ".";
+		}
+	}
+
+	ImGui::Checkbox("Continue from current structures", &continueFromCurrent);
+
+	if (ingestJob.running) {
+		ImGui::Text("Stop the queue stream before running a script.");
+	}
+	else if (!batchRun.running && ImGui::Button("Run Script")) {
+		startBatchScript(script, list, stack, queue, continueFromCurrent, message);
+	}
+	if (batchRun.running && ImGui::Button("Cancel")) {
+		batchRun.cancel = true;
+	}
+
+	if (!message.empty()) {
+		ImGui::TextWrapped("%s", message.c_str());
+	}
+
+	if (batchRun.running) {
+		float fraction = batchRun.plannedOps > 0 ? (float)batchRun.progress / batchRun.plannedOps : 1.0f;
+		ImGui::ProgressBar(fraction);
+	}
+	else if (!batchRun.steps.empty()) {
+		// Throughput report for the last run
+		long long totalOps = 0;
+		for (const BatchStepReport& step : batchRun.steps) totalOps += step.operations;
+		ImGui::Text("%lld operations in %.3f s (%.2f Mops/s)", totalOps, batchRun.seconds,
+			batchRun.seconds > 0.0 ? totalOps / batchRun.seconds / 1e6 : 0.0);
+		ImGui::Separator();
+		for (const BatchStepReport& step : batchRun.steps) {
+			ImGui::Text("%-32s %12lld ops %10.2f ms %8.2f Mops/s", step.text.c_str(), step.operations, step.milliseconds,
+				step.milliseconds > 0.0 ? step.operations / step.milliseconds / 1e3 : 0.0);
+		}
+		ImGui::Separator();
+		ImGui::Text("Linked list: %zu nodes, Stack: %zu elements, Queue: %zu elements", list.count, stack.GetData().size(), queue.size());
+	}
+
+	ImGui::End();
+}
+
+// Shared look for the interactive window and headless capture
+void ApplyAppStyle() {
 	ImGui::StyleColorsClassic();
 
 	// For more robust UI
@@ -803,12 +3123,1290 @@ int main() {
 	ImGui::PushStyleColor(ImGuiCol_Button, buttonColor);
 	ImGui::PushStyleColor(ImGuiCol_ButtonHovered, buttonHoveredColor);
 	ImGui::PushStyleColor(ImGuiCol_ButtonActive, buttonActiveColor);
+}
+
+// Headless Capture
+//
+// Renders one view into an offscreen framebuffer of a hidden window at a fixed
+// simulated timestep, reads frames back through a ring of pixel buffer objects
+// and hands them to a pool of encoder threads. Examples:
+//   VisAl --capture sorting --algorithm 3 --element float --values 200 --fps 60 --out capture/frame
+//   VisAl --capture queue --script "enqueue 1..20" --frames 60 --format raw
+
+struct CaptureOptions {
+	std::string view = "sorting"; // sorting, queue, stack or list
+	std::string output = "frame"; // Output path prefix (its directory must exist)
+	std::string script;           // Batch script run before capturing
+	bool rawStream = false;       // One raw RGBA stream instead of PNG files
+	int frames = 0;               // 0: until the sort finishes (60 frames for other views)
+	int width = 1280, height = 720;
+	double timestep = 1.0 / 60.0; // Simulated seconds per frame
+	int algorithm = 0;            // Index into the sorting window's algorithm list
+	int elementType = ElementInt32;
+	int values = 50;
+	int speed = 50;               // Simulated milliseconds per sorting step
+	int encoders = 0;             // 0: one per hardware thread
+};
+
+// Returns true when the command line asks for headless capture
+bool parseCaptureArgs(int argc, char** argv, CaptureOptions& options) {
+	bool capture = false;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--capture" && hasValue) { capture = true; options.view = argv[++i]; }
+		else if (arg == "--out" && hasValue) options.output = argv[++i];
+		else if (arg == "--script" && hasValue) options.script = argv[++i];
+		else if (arg == "--format" && hasValue) options.rawStream = std::string(argv[++i]) == "raw";
+		else if (arg == "--frames" && hasValue) options.frames = std::atoi(argv[++i]);
+		else if (arg == "--size" && hasValue) std::sscanf(argv[++i], "%dx%d", &options.width, &options.height);
+		else if (arg == "--fps" && hasValue) options.timestep = 1.0 / std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--algorithm" && hasValue) options.algorithm = std::atoi(argv[++i]);
+		else if (arg == "--element" && hasValue) {
+			std::string type = argv[++i];
+			options.elementType = type == "int64" ? ElementInt64 : type == "float" ? ElementFloat : type == "keyvalue" ? ElementKeyValue : ElementInt32;
+		}
+		else if (arg == "--values" && hasValue) options.values = std::atoi(argv[++i]);
+		else if (arg == "--speed" && hasValue) options.speed = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--encoders" && hasValue) options.encoders = std::atoi(argv[++i]);
+	}
+	if (options.frames <= 0 && options.view != "sorting") options.frames = 60;
+	return capture;
+}
+
+// Writes an RGBA image as a PNG using stored (uncompressed) deflate blocks, which
+// keeps encoding cheap and dependency-free. Rows are flipped since GL reads bottom-up.
+uint32_t pngCrc(uint32_t crc, const unsigned char* bytes, size_t n) {
+	static const std::vector<uint32_t> table = []() {
+		std::vector<uint32_t> t(256);
+		for (uint32_t i = 0; i < 256; ++i) {
+			uint32_t c = i;
+			for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			t[i] = c;
+		}
+		return t;
+	}();
+	crc = ~crc;
+	for (size_t i = 0; i < n; ++i) crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+void pngPut32(std::vector<unsigned char>& out, uint32_t value) {
+	out.push_back((unsigned char)(value >> 24));
+	out.push_back((unsigned char)(value >> 16));
+	out.push_back((unsigned char)(value >> 8));
+	out.push_back((unsigned char)value);
+}
+
+void pngChunk(std::FILE* file, const char* type, const unsigned char* payload, size_t n) {
+	unsigned char header[8] = { (unsigned char)(n >> 24), (unsigned char)(n >> 16), (unsigned char)(n >> 8), (unsigned char)n };
+	std::memcpy(header + 4, type, 4);
+	uint32_t crc = pngCrc(pngCrc(0, header + 4, 4), payload, n);
+	unsigned char footer[4] = { (unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8), (unsigned char)crc };
+	std::fwrite(header, 1, 8, file);
+	if (n > 0) std::fwrite(payload, 1, n, file);
+	std::fwrite(footer, 1, 4, file);
+}
+
+bool writePng(const std::string& path, const unsigned char* rgba, int width, int height,
+	std::vector<unsigned char>& scanlines, std::vector<unsigned char>& zlib) {
+	size_t rowBytes = (size_t)width * 4;
+	scanlines.resize((rowBytes + 1) * height);
+	for (int y = 0; y < height; ++y) {
+		unsigned char* row = &scanlines[y * (rowBytes + 1)];
+		row[0] = 0; // Filter: none
+		std::memcpy(row + 1, rgba + (size_t)(height - 1 - y) * rowBytes, rowBytes);
+	}
+
+	zlib.clear();
+	zlib.push_back(0x78);
+	zlib.push_back(0x01);
+	uint32_t adlerA = 1, adlerB = 0;
+	for (size_t pos = 0; pos < scanlines.size();) {
+		size_t n = std::min<size_t>(65535, scanlines.size() - pos);
+		zlib.push_back(pos + n == scanlines.size() ? 1 : 0);
+		zlib.push_back((unsigned char)n);
+		zlib.push_back((unsigned char)(n >> 8));
+		zlib.push_back((unsigned char)~n);
+		zlib.push_back((unsigned char)(~n >> 8));
+		zlib.insert(zlib.end(), scanlines.begin() + pos, scanlines.begin() + pos + n);
+		for (size_t i = pos; i < pos + n; ++i) {
+			adlerA = (adlerA + scanlines[i]) % 65521;
+			adlerB = (adlerB + adlerA) % 65521;
+		}
+		pos += n;
+	}
+	pngPut32(zlib, (adlerB << 16) | adlerA);
+
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file) return false;
+	static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	std::fwrite(signature, 1, 8, file);
+	std::vector<unsigned char> ihdr;
+	pngPut32(ihdr, width);
+	pngPut32(ihdr, height);
+	unsigned char format[5] = { 8, 6, 0, 0, 0 }; // 8-bit RGBA, no interlace
+	ihdr.insert(ihdr.end(), format, format + 5);
+	pngChunk(file, "IHDR", ihdr.data(), ihdr.size());
+	pngChunk(file, "IDAT", zlib.data(), zlib.size());
+	pngChunk(file, "IEND", nullptr, 0);
+	return std::fclose(file) == 0;
+}
+
+// Encodes frames on worker threads. Submitting blocks when the queue is full so a
+// slow disk throttles the capture loop instead of growing memory without bound.
+class FrameEncoder {
+public:
+	FrameEncoder(const CaptureOptions& options) : options(options) {
+		int workers = options.encoders > 0 ? options.encoders : (int)std::max(1u, std::thread::hardware_concurrency());
+		if (options.rawStream) {
+			// A single writer keeps the stream in frame order
+			workers = 1;
+			stream = std::fopen((options.output + ".rgba").c_str(), "wb");
+			if (!stream) failed = true; // RunCapture checks this before rendering anything
+		}
+		maxQueued = workers * 2;
+		for (int i = 0; i < workers; ++i) {
+			threads.emplace_back([this]() { workerLoop(); });
+		}
+	}
+
+	~FrameEncoder() {
+		finish();
+	}
+
+	// Returns a frame buffer, reusing one an encoder has finished with
+	std::vector<unsigned char> acquireBuffer() {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::vector<unsigned char> buffer;
+		if (!pool.empty()) {
+			buffer.swap(pool.back());
+			pool.pop_back();
+		}
+		buffer.resize((size_t)options.width * options.height * 4);
+		return buffer;
+	}
+
+	void submit(int index, std::vector<unsigned char>&& pixels) {
+		std::unique_lock<std::mutex> lock(mutex);
+		notFull.wait(lock, [this]() { return (int)pending.size() < maxQueued; });
+		pending.push_back(std::make_pair(index, std::move(pixels)));
+		notEmpty.notify_one();
+	}
+
+	// Drains the queue and joins the workers
+	void finish() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			done = true;
+		}
+		notEmpty.notify_all();
+		for (std::thread& t : threads) {
+			if (t.joinable()) t.join();
+		}
+		if (stream) {
+			if (std::fclose(stream) != 0) failed = true;
+			stream = nullptr;
+		}
+	}
+
+	std::atomic<bool> failed{ false };
+
+private:
+	void workerLoop() {
+		std::vector<unsigned char> scanlines, zlib;
+		char path[512];
+		while (true) {
+			std::pair<int, std::vector<unsigned char>> frame;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				notEmpty.wait(lock, [this]() { return !pending.empty() || done; });
+				if (pending.empty()) return;
+				frame = std::move(pending.front());
+				pending.pop_front();
+				notFull.notify_one();
+			}
+
+			const unsigned char* pixels = frame.second.data();
+			size_t rowBytes = (size_t)options.width * 4;
+			if (options.rawStream) {
+				for (int y = options.height - 1; y >= 0; --y) {
+					if (std::fwrite(pixels + y * rowBytes, 1, rowBytes, stream) != rowBytes) failed = true;
+				}
+			}
+			else {
+				std::snprintf(path, sizeof(path), "%s_%06d.png", options.output.c_str(), frame.first);
+				if (!writePng(path, pixels, options.width, options.height, scanlines, zlib)) failed = true;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			pool.push_back(std::move(frame.second));
+		}
+	}
+
+	CaptureOptions options;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable notEmpty, notFull;
+	std::deque<std::pair<int, std::vector<unsigned char>>> pending;
+	std::vector<std::vector<unsigned char>> pool;
+	int maxQueued = 2;
+	bool done = false;
+	std::FILE* stream = nullptr;
+};
+
+#ifdef CAPTURE_USE_EGL
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+#endif
+
+// OpenGL context for capture. With EGL it is created on Mesa's surfaceless
+// platform (or the default display) and made current without any surface, since
+// everything renders into a framebuffer object; a 1x1 pbuffer covers drivers
+// without surfaceless contexts. A hidden GLFW window is the fallback where EGL
+// isn't available, and that one still needs a desktop session.
+struct CaptureContext {
+	GLFWwindow* window = nullptr;
+#ifdef CAPTURE_USE_EGL
+	EGLDisplay display = EGL_NO_DISPLAY;
+	EGLContext context = EGL_NO_CONTEXT;
+	EGLSurface surface = EGL_NO_SURFACE;
+#endif
+
+	bool create(int width, int height) {
+#ifdef CAPTURE_USE_EGL
+		if (createEgl()) return true;
+		destroy();
+#endif
+		if (!glfwInit()) return false;
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		window = glfwCreateWindow(width, height, "Capture", NULL, NULL);
+		if (!window) {
+			glfwTerminate();
+			return false;
+		}
+		glfwMakeContextCurrent(window);
+		glfwSwapInterval(0);
+		return true;
+	}
+
+	void* getProcAddress(const char* name) const {
+#ifdef CAPTURE_USE_EGL
+		if (context != EGL_NO_CONTEXT) return reinterpret_cast<void*>(eglGetProcAddress(name));
+#endif
+		return reinterpret_cast<void*>(glfwGetProcAddress(name));
+	}
+
+	void destroy() {
+#ifdef CAPTURE_USE_EGL
+		if (display != EGL_NO_DISPLAY) {
+			eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			if (surface != EGL_NO_SURFACE) eglDestroySurface(display, surface);
+			if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+			eglTerminate(display);
+		}
+		display = EGL_NO_DISPLAY;
+		context = EGL_NO_CONTEXT;
+		surface = EGL_NO_SURFACE;
+#endif
+		if (window) {
+			glfwDestroyWindow(window);
+			glfwTerminate();
+			window = nullptr;
+		}
+	}
+
+#ifdef CAPTURE_USE_EGL
+private:
+	bool createEgl() {
+		typedef EGLDisplay(EGLAPIENTRY* GetPlatformDisplay)(EGLenum, void*, const EGLint*);
+		GetPlatformDisplay getPlatformDisplay = reinterpret_cast<GetPlatformDisplay>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		if (display == EGL_NO_DISPLAY) return false;
+		EGLint major, minor;
+		if (!eglInitialize(display, &major, &minor)) {
+			display = EGL_NO_DISPLAY;
+			return false;
+		}
+		if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+		// Pbuffer-capable configs suit the fallback too (the default asks for window surfaces)
+		const EGLint configAttribs[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_NONE };
+		EGLConfig config;
+		EGLint configs = 0;
+		if (!eglChooseConfig(display, configAttribs, &config, 1, &configs) || configs == 0) return false;
+		context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+		if (context == EGL_NO_CONTEXT) return false;
+		if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) return true;
+
+		const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+		surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+		return surface != EGL_NO_SURFACE && eglMakeCurrent(display, surface, surface, context);
+	}
+#endif
+};
+
+// OpenGL entry points beyond 1.1, loaded through the capture context
+#ifdef _WIN32
+#define CAPTURE_GLAPI __stdcall
+#else
+#define CAPTURE_GLAPI
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+
+struct CaptureGL {
+	void (CAPTURE_GLAPI* GenBuffers)(GLsizei, GLuint*);
+	void (CAPTURE_GLAPI* DeleteBuffers)(GLsizei, const GLuint*);
+	void (CAPTURE_GLAPI* BindBuffer)(GLenum, GLuint);
+	void (CAPTURE_GLAPI* BufferData)(GLenum, std::ptrdiff_t, const void*, GLenum);
+	void* (CAPTURE_GLAPI* MapBuffer)(GLenum, GLenum);
+	GLboolean(CAPTURE_GLAPI* UnmapBuffer)(GLenum);
+	void (CAPTURE_GLAPI* GenFramebuffers)(GLsizei, GLuint*);
+	void (CAPTURE_GLAPI* DeleteFramebuffers)(GLsizei, const GLuint*);
+	void (CAPTURE_GLAPI* BindFramebuffer)(GLenum, GLuint);
+	void (CAPTURE_GLAPI* GenRenderbuffers)(GLsizei, GLuint*);
+	void (CAPTURE_GLAPI* DeleteRenderbuffers)(GLsizei, const GLuint*);
+	void (CAPTURE_GLAPI* BindRenderbuffer)(GLenum, GLuint);
+	void (CAPTURE_GLAPI* RenderbufferStorage)(GLenum, GLenum, GLsizei, GLsizei);
+	void (CAPTURE_GLAPI* FramebufferRenderbuffer)(GLenum, GLenum, GLenum, GLuint);
+	GLenum(CAPTURE_GLAPI* CheckFramebufferStatus)(GLenum);
+
+	const CaptureContext* context = nullptr;
+
+	template <typename F>
+	bool load(F& fn, const char* name) {
+		fn = reinterpret_cast<F>(context->getProcAddress(name));
+		return fn != nullptr;
+	}
+
+	bool loadAll(const CaptureContext& source) {
+		context = &source;
+		return load(GenBuffers, "glGenBuffers") && load(DeleteBuffers, "glDeleteBuffers") &&
+			load(BindBuffer, "glBindBuffer") && load(BufferData, "glBufferData") &&
+			load(MapBuffer, "glMapBuffer") && load(UnmapBuffer, "glUnmapBuffer") &&
+			load(GenFramebuffers, "glGenFramebuffers") && load(DeleteFramebuffers, "glDeleteFramebuffers") &&
+			load(BindFramebuffer, "glBindFramebuffer") && load(GenRenderbuffers, "glGenRenderbuffers") &&
+			load(DeleteRenderbuffers, "glDeleteRenderbuffers") && load(BindRenderbuffer, "glBindRenderbuffer") &&
+			load(RenderbufferStorage, "glRenderbufferStorage") &&
+			load(FramebufferRenderbuffer, "glFramebufferRenderbuffer") &&
+			load(CheckFramebufferStatus, "glCheckFramebufferStatus");
+	}
+};
+
+int RunCapture(const CaptureOptions& options) {
+	if (options.view == "sorting" && (options.algorithm < 0 || options.algorithm >= sortAlgorithmCount)) {
+		std::fprintf(stderr, "--algorithm must be 0..%d.\n", sortAlgorithmCount - 1);
+		return -1;
+	}
+	if (options.view == "sorting" && options.values < 1) {
+		std::fprintf(stderr, "--values must be at least 1.\n");
+		return -1;
+	}
+
+	FrameEncoder encoder(options);
+	if (encoder.failed) {
+		std::fprintf(stderr, "Could not open %s.rgba for writing.\n", options.output.c_str());
+		return -1;
+	}
+
+	CaptureContext context;
+	if (!context.create(options.width, options.height)) {
+		std::fprintf(stderr, "Could not create an OpenGL context for capture.\n");
+		return -1;
+	}
+
+	CaptureGL gl;
+	if (!gl.loadAll(context)) {
+		std::fprintf(stderr, "Capture needs framebuffer and pixel buffer object support.\n");
+		context.destroy();
+		return -1;
+	}
+
+	// No platform backend: there may be no window, and capture takes no input.
+	// The display size and timestep are set by hand every frame instead.
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGui_ImplOpenGL3_Init("#version 130");
+	ApplyAppStyle();
+	ImGui::GetIO().IniFilename = nullptr; // Keep capture runs reproducible
+
+	// Offscreen color target
+	GLuint fbo = 0, colorBuffer = 0;
+	gl.GenFramebuffers(1, &fbo);
+	gl.GenRenderbuffers(1, &colorBuffer);
+	gl.BindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+	gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, options.width, options.height);
+	gl.BindFramebuffer(GL_FRAMEBUFFER, fbo);
+	gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+	if (gl.CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		std::fprintf(stderr, "Offscreen framebuffer is incomplete.\n");
+		return -1;
+	}
+
+	// Ring of pixel buffers: frame N is read back while N+1 and N+2 are rendering
+	const int pboCount = 3;
+	size_t frameBytes = (size_t)options.width * options.height * 4;
+	GLuint pbos[pboCount];
+	gl.GenBuffers(pboCount, pbos);
+	for (int i = 0; i < pboCount; ++i) {
+		gl.BindBuffer(GL_PIXEL_PACK_BUFFER, pbos[i]);
+		gl.BufferData(GL_PIXEL_PACK_BUFFER, (std::ptrdiff_t)frameBytes, nullptr, GL_STREAM_READ);
+	}
+	gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	// Scene setup
+	LinkedList list;
+	Stack stack;
+	Queue queue;
+	if (!options.script.empty()) {
+		BatchStructures built;
+		std::vector<BatchOp> ops;
+		std::vector<BatchStepReport> steps;
+		std::string error;
+		std::atomic<long long> progress{ 0 };
+		std::atomic<bool> cancel{ false };
+		if (!parseBatchScript(options.script, ops, error)) {
+			std::fprintf(stderr, "%s\n", error.c_str());
+			return -1;
+		}
+		runBatchScript(ops, built, steps, progress, cancel);
+		list.swap(built.list);
+		stack.Swap(built.stack);
+		queue.swap(built.queue);
+	}
+	bool sorting = options.view == "sorting";
+	if (sorting) {
+		// Through the view's own state so the captured controls show the same settings
+		elementType = options.elementType;
+		sortAlgorithm = options.algorithm;
+		sortValueCount = options.values;
+		generateRandomData(sortValueCount);
+		sortSpeed = options.speed;
+		sortStepGate.enabled = true;
+		startSorting(sortAlgorithm);
+	}
+
+	auto readBack = [&](int frame) {
+		gl.BindBuffer(GL_PIXEL_PACK_BUFFER, pbos[frame % pboCount]);
+		const unsigned char* mapped = static_cast<const unsigned char*>(gl.MapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+		if (mapped) {
+			std::vector<unsigned char> pixels = encoder.acquireBuffer();
+			std::memcpy(pixels.data(), mapped, frameBytes);
+			gl.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			encoder.submit(frame, std::move(pixels));
+		}
+		gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	};
+
+	auto wallStart = std::chrono::high_resolution_clock::now();
+	double stepBudget = 0.0;
+	int tailFrames = (int)(1.0 / options.timestep); // Hold the sorted result for a second
+	int frame = 0;
+	for (;; ++frame) {
+		if (options.frames > 0 && frame >= options.frames) break;
+		if (options.frames <= 0 && !isSorting && tailFrames-- <= 0) break;
+
+		// Advance the sort by the steps that fit in one simulated timestep
+		if (sorting) {
+			stepBudget += options.timestep * 1000.0 / sortSpeed;
+			long long steps = (long long)stepBudget;
+			stepBudget -= steps;
+			releaseSortSteps(steps);
+		}
+
+		ImGui_ImplOpenGL3_NewFrame();
+		ImGui::GetIO().DisplaySize = ImVec2((float)options.width, (float)options.height);
+		ImGui::GetIO().DeltaTime = (float)options.timestep;
+		ImGui::NewFrame();
+
+		ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+		ImGui::SetNextWindowSize(ImVec2((float)options.width, (float)options.height), ImGuiCond_Always);
+		if (sorting) RenderSorting();
+		else if (options.view == "queue") RenderQueue(queue);
+		else if (options.view == "stack") RenderStackUI(stack);
+		else RenderLinkedList(list);
+
+		ImGui::Render();
+		gl.BindFramebuffer(GL_FRAMEBUFFER, fbo);
+		glViewport(0, 0, options.width, options.height);
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+		// Start an asynchronous read of this frame and collect the oldest one in flight
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		gl.BindBuffer(GL_PIXEL_PACK_BUFFER, pbos[frame % pboCount]);
+		glReadPixels(0, 0, options.width, options.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		if (frame >= pboCount - 1) {
+			readBack(frame - (pboCount - 1));
+		}
+	}
+	for (int pending = std::max(0, frame - (pboCount - 1)); pending < frame; ++pending) {
+		readBack(pending);
+	}
+	encoder.finish();
+
+	double wallSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - wallStart).count();
+	double simulatedSeconds = frame * options.timestep;
+	std::printf("Captured %d frames (%.2f s simulated) in %.2f s: %.1f fps, %.1fx real time\n",
+		frame, simulatedSeconds, wallSeconds, wallSeconds > 0.0 ? frame / wallSeconds : 0.0,
+		wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0);
+	if (encoder.failed) {
+		std::fprintf(stderr, "Some frames could not be written to %s.\n", options.output.c_str());
+	}
+
+	// Cleanup
+	stopSorting();
+	sortStepGate.enabled = false;
+	gl.DeleteBuffers(pboCount, pbos);
+	gl.DeleteRenderbuffers(1, &colorBuffer);
+	gl.DeleteFramebuffers(1, &fbo);
+	ImGui_ImplOpenGL3_Shutdown();
+	ImGui::DestroyContext();
+	context.destroy();
+
+	return encoder.failed ? 1 : 0;
+}
+
+// Formats a byte count into buf without allocating
+const char* formatBytes(char* buf, size_t size, double bytes) {
+	const char* units[] = { "B", "KB", "MB", "GB" };
+	int unit = 0;
+	while (std::fabs(bytes) >= 1024.0 && unit < 3) {
+		bytes /= 1024.0;
+		unit++;
+	}
+	std::snprintf(buf, size, unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+	return buf;
+}
+
+// Graph Classes and Functions
+//
+// Graphs are stored in compressed sparse row (CSR) layout: the neighbours of
+// vertex v are targets[offsets[v]] .. targets[offsets[v + 1] - 1], with the
+// matching edge weights alongside. Undirected graphs store each edge twice.
+
+struct GraphEdge {
+	int from, to;
+	uint32_t weight;
+};
+
+struct CsrGraph {
+	int vertices = 0;
+	bool undirected = true;
+	std::vector<int64_t> offsets;
+	std::vector<int> targets;
+	std::vector<uint32_t> weights;
+	std::vector<long long> vertexIds; // Id in the edge list file of each vertex (empty: ids are indices)
+
+	// Layout: explicit positions (force-directed, small graphs) or a row-major grid
+	std::vector<ImVec2> positions; // Normalized to 0..1
+	int layoutWidth = 1;
+	int layoutHeight = 1;
+
+	int64_t edges() const { return (int64_t)targets.size(); }
+	int64_t degree(int v) const { return offsets[v + 1] - offsets[v]; }
+
+	ImVec2 position(int v) const {
+		if (!positions.empty()) return positions[v];
+		return ImVec2((v % layoutWidth + 0.5f) / layoutWidth, (v / layoutWidth + 0.5f) / layoutHeight);
+	}
+};
+
+// Builds the CSR arrays from an edge list with a counting sort by source
+void buildCsr(CsrGraph& g, int vertices, const std::vector<GraphEdge>& edges, bool undirected) {
+	g.vertices = vertices;
+	g.undirected = undirected;
+	g.offsets.assign((size_t)vertices + 1, 0);
+	for (const GraphEdge& e : edges) {
+		g.offsets[e.from + 1]++;
+		if (undirected) g.offsets[e.to + 1]++;
+	}
+	for (int v = 0; v < vertices; ++v) g.offsets[v + 1] += g.offsets[v];
+
+	g.targets.resize((size_t)g.offsets[vertices]);
+	g.weights.resize((size_t)g.offsets[vertices]);
+	std::vector<int64_t> next(g.offsets.begin(), g.offsets.end() - 1);
+	for (const GraphEdge& e : edges) {
+		int64_t i = next[e.from]++;
+		g.targets[i] = e.to;
+		g.weights[i] = e.weight;
+		if (undirected) {
+			int64_t j = next[e.to]++;
+			g.targets[j] = e.from;
+			g.weights[j] = e.weight;
+		}
+	}
+
+	g.positions.clear();
+	g.vertexIds.clear();
+	g.layoutWidth = std::max(1, (int)std::ceil(std::sqrt((double)vertices)));
+	g.layoutHeight = std::max(1, (vertices + g.layoutWidth - 1) / g.layoutWidth);
+}
+
+// width x height grid with 4-neighbour edges, laid out as the grid itself
+void generateGridGraph(CsrGraph& g, int width, int height, std::mt19937& rng) {
+	width = std::max(1, width);
+	height = std::max(1, std::min(height, INT_MAX / width)); // Vertex ids are ints
+	std::vector<GraphEdge> edges;
+	edges.reserve((size_t)width * height * 2);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			int v = y * width + x;
+			if (x + 1 < width) edges.push_back({ v, v + 1, (uint32_t)(rng() % 100 + 1) });
+			if (y + 1 < height) edges.push_back({ v, v + width, (uint32_t)(rng() % 100 + 1) });
+		}
+	}
+	buildCsr(g, width * height, edges, true);
+	g.layoutWidth = width;
+	g.layoutHeight = height;
+}
+
+// Uniform random graph with the given average degree
+void generateRandomGraph(CsrGraph& g, int vertices, int averageDegree, std::mt19937& rng) {
+	std::vector<GraphEdge> edges;
+	int64_t count = (int64_t)vertices * averageDegree / 2;
+	edges.reserve((size_t)count);
+	std::uniform_int_distribution<int> pick(0, std::max(0, vertices - 1));
+	for (int64_t i = 0; i < count && vertices > 1; ++i) {
+		int from = pick(rng), to = pick(rng);
+		if (from != to) edges.push_back({ from, to, (uint32_t)(rng() % 100 + 1) });
+	}
+	buildCsr(g, vertices, edges, true);
+}
+
+// Loads "from to [weight]" lines; '#' and '%' start comments
+bool loadGraphFile(CsrGraph& g, const std::string& path, bool undirected, std::string& error) {
+	std::ifstream file(path);
+	if (!file) {
+		error = "Could not open " + path + ".";
+		return false;
+	}
+	// Ids can be sparse (e.g. SNAP dumps with ids near 2^31), so they're renumbered
+	// to dense indices in order of first appearance
+	std::vector<GraphEdge> edges;
+	std::vector<long long> ids;
+	std::unordered_map<long long, int> index;
+	auto vertexIndex = [&](long long id) {
+		auto found = index.emplace(id, (int)ids.size());
+		if (found.second) ids.push_back(id);
+		return found.first->second;
+	};
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#' || line[0] == '%') continue;
+		long long from, to, weight = 1;
+		int fields = std::sscanf(line.c_str(), "%lld %lld %lld", &from, &to, &weight);
+		if (fields < 2) continue;
+		if (weight < 0) {
+			error = "Invalid edge: " + line;
+			return false;
+		}
+		if (ids.size() >= (size_t)INT_MAX - 2) {
+			error = "Too many vertices in " + path + ".";
+			return false;
+		}
+		int u = vertexIndex(from);
+		int v = vertexIndex(to);
+		edges.push_back({ u, v, (uint32_t)std::min<long long>(weight, UINT32_MAX) });
+	}
+	buildCsr(g, (int)ids.size(), edges, undirected);
+	g.vertexIds.swap(ids);
+	return true;
+}
+
+// Fruchterman-Reingold layout; O(V^2) per iteration, so only used for small graphs
+void forceDirectedLayout(CsrGraph& g, int iterations, std::mt19937& rng) {
+	int n = g.vertices;
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	g.positions.resize(n);
+	for (ImVec2& p : g.positions) p = ImVec2(unit(rng), unit(rng));
+
+	std::vector<ImVec2> shift(n);
+	float k = std::sqrt(1.0f / std::max(1, n)); // Ideal edge length
+	float temperature = 0.1f;
+	for (int it = 0; it < iterations; ++it) {
+		std::fill(shift.begin(), shift.end(), ImVec2(0, 0));
+		for (int v = 0; v < n; ++v) {
+			for (int u = v + 1; u < n; ++u) {
+				float dx = g.positions[v].x - g.positions[u].x, dy = g.positions[v].y - g.positions[u].y;
+				float d2 = std::max(dx * dx + dy * dy, 1e-6f);
+				float f = k * k / d2; // Repulsion k^2/d, applied along (dx, dy)/d
+				shift[v].x += dx * f; shift[v].y += dy * f;
+				shift[u].x -= dx * f; shift[u].y -= dy * f;
+			}
+			for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+				int u = g.targets[e];
+				float dx = g.positions[v].x - g.positions[u].x, dy = g.positions[v].y - g.positions[u].y;
+				float d = std::sqrt(dx * dx + dy * dy);
+				float f = d / k; // Attraction d^2/k
+				shift[v].x -= dx * f; shift[v].y -= dy * f;
+			}
+		}
+		for (int v = 0; v < n; ++v) {
+			float length = std::max(std::sqrt(shift[v].x * shift[v].x + shift[v].y * shift[v].y), 1e-6f);
+			float step = std::min(length, temperature);
+			g.positions[v].x = std::min(0.98f, std::max(0.02f, g.positions[v].x + shift[v].x / length * step));
+			g.positions[v].y = std::min(0.98f, std::max(0.02f, g.positions[v].y + shift[v].y / length * step));
+		}
+		temperature *= 0.95f;
+	}
+}
+
+// Runs f(begin, end, thread) over [0, n) split across threads; small ranges run inline
+template <typename F>
+void parallelFor(size_t n, int threads, F f) {
+	if (threads <= 1 || n < 4096) {
+		f((size_t)0, n, 0);
+		return;
+	}
+	size_t chunk = (n + threads - 1) / threads;
+	std::vector<std::thread> workers;
+	for (int t = 1; t < threads && t * chunk < n; ++t) {
+		workers.emplace_back(f, t * chunk, std::min(n, (t + 1) * chunk), t);
+	}
+	f((size_t)0, std::min(n, chunk), 0);
+	for (std::thread& w : workers) w.join();
+}
+
+struct TraversalResult {
+	std::vector<int> time;   // BFS level or Dijkstra settle order per vertex, -1 if unreached
+	int maxTime = 0;
+	int reached = 0;
+	int64_t edgesTraversed = 0; // Sum of the degrees of reached vertices
+	double seconds = 0.0;
+	int bottomUpSteps = 0;
+	int totalSteps = 0;
+	uint32_t maxDistance = 0;
+};
+
+// Direction-optimizing BFS: expands the frontier top-down (frontier -> neighbours)
+// while it is small and switches to bottom-up (unvisited vertices look for a
+// parent in the frontier) once the frontier's edges outnumber the unexplored
+// edges / alpha. Bottom-up needs incoming edges, so directed graphs stay top-down.
+void breadthFirstSearch(const CsrGraph& g, int source, int threads, TraversalResult& result) {
+	const int64_t alpha = 14, beta = 24;
+	int n = g.vertices;
+	std::vector<std::atomic<int>> level(n);
+	for (int v = 0; v < n; ++v) level[v].store(-1, std::memory_order_relaxed);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	std::vector<int> frontier(1, source);
+	std::vector<std::vector<int>> localNext(std::max(1, threads));
+	level[source] = 0;
+	int64_t unexploredEdges = g.edges() - g.degree(source);
+	int64_t frontierEdges = g.degree(source);
+	bool bottomUp = false;
+	int depth = 0;
+	result.bottomUpSteps = 0;
+
+	while (!frontier.empty()) {
+		if (g.undirected) {
+			if (!bottomUp && frontierEdges > unexploredEdges / alpha) bottomUp = true;
+			else if (bottomUp && (int64_t)frontier.size() < n / beta) bottomUp = false;
+		}
+		for (std::vector<int>& next : localNext) next.clear();
+
+		if (bottomUp) {
+			result.bottomUpSteps++;
+			parallelFor((size_t)n, threads, [&](size_t begin, size_t end, int t) {
+				for (size_t v = begin; v < end; ++v) {
+					if (level[v].load(std::memory_order_relaxed) != -1) continue;
+					for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+						if (level[g.targets[e]].load(std::memory_order_relaxed) == depth) {
+							level[v].store(depth + 1, std::memory_order_relaxed);
+							localNext[t].push_back((int)v);
+							break;
+						}
+					}
+				}
+				});
+		}
+		else {
+			parallelFor(frontier.size(), threads, [&](size_t begin, size_t end, int t) {
+				for (size_t i = begin; i < end; ++i) {
+					int v = frontier[i];
+					for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+						int u = g.targets[e];
+						int unvisited = -1;
+						if (level[u].load(std::memory_order_relaxed) == -1 &&
+							level[u].compare_exchange_strong(unvisited, depth + 1, std::memory_order_relaxed)) {
+							localNext[t].push_back(u);
+						}
+					}
+				}
+				});
+		}
+
+		frontier.clear();
+		frontierEdges = 0;
+		for (const std::vector<int>& next : localNext) {
+			for (int v : next) frontierEdges += g.degree(v);
+			frontier.insert(frontier.end(), next.begin(), next.end());
+		}
+		unexploredEdges -= frontierEdges;
+		depth++;
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	result.totalSteps = depth;
+
+	result.time.resize(n);
+	result.reached = 0;
+	result.edgesTraversed = 0;
+	result.maxTime = 0;
+	for (int v = 0; v < n; ++v) {
+		result.time[v] = level[v].load(std::memory_order_relaxed);
+		if (result.time[v] >= 0) {
+			result.reached++;
+			result.edgesTraversed += g.degree(v);
+			result.maxTime = std::max(result.maxTime, result.time[v]);
+		}
+	}
+}
+
+inline int bitWidth(uint32_t x) {
+#ifdef _MSC_VER
+	unsigned long index;
+	return _BitScanReverse(&index, x) ? (int)index + 1 : 0;
+#else
+	return x ? 32 - __builtin_clz(x) : 0;
+#endif
+}
+
+// Monotone priority queue for unsigned integer keys. An entry sits in the bucket
+// of the highest bit in which its key differs from the last popped key; popping
+// from an empty bucket 0 redistributes the next non-empty bucket, so each entry
+// moves at most 32 times.
+class RadixHeap {
+public:
+	bool empty() const { return count == 0; }
+
+	void push(uint32_t key, int vertex) {
+		buckets[bitWidth(key ^ last)].push_back(std::make_pair(key, vertex));
+		count++;
+	}
+
+	std::pair<uint32_t, int> pop() {
+		if (buckets[0].empty()) {
+			int i = 1;
+			while (buckets[i].empty()) i++;
+			uint32_t newLast = UINT32_MAX;
+			for (const auto& entry : buckets[i]) newLast = std::min(newLast, entry.first);
+			last = newLast;
+			for (const auto& entry : buckets[i]) buckets[bitWidth(entry.first ^ last)].push_back(entry);
+			buckets[i].clear();
+		}
+		std::pair<uint32_t, int> top = buckets[0].back();
+		buckets[0].pop_back();
+		count--;
+		return top;
+	}
+
+private:
+	std::vector<std::pair<uint32_t, int>> buckets[33];
+	uint32_t last = 0;
+	size_t count = 0;
+};
+
+void dijkstra(const CsrGraph& g, int source, TraversalResult& result) {
+	int n = g.vertices;
+	std::vector<uint32_t> dist(n, UINT32_MAX);
+	result.time.assign(n, -1);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	RadixHeap heap;
+	dist[source] = 0;
+	heap.push(0, source);
+	int settled = 0;
+	while (!heap.empty()) {
+		std::pair<uint32_t, int> top = heap.pop();
+		int v = top.second;
+		if (top.first > dist[v] || result.time[v] >= 0) continue; // Stale entry
+		result.time[v] = settled++;
+		for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+			int u = g.targets[e];
+			uint32_t candidate = (uint32_t)std::min<uint64_t>((uint64_t)dist[v] + g.weights[e], UINT32_MAX - 1);
+			if (candidate < dist[u]) {
+				dist[u] = candidate;
+				heap.push(candidate, u);
+			}
+		}
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+	result.reached = settled;
+	result.maxTime = std::max(0, settled - 1);
+	result.totalSteps = settled;
+	result.bottomUpSteps = 0;
+	result.edgesTraversed = 0;
+	result.maxDistance = 0;
+	for (int v = 0; v < n; ++v) {
+		if (result.time[v] >= 0) {
+			result.edgesTraversed += g.degree(v);
+			result.maxDistance = std::max(result.maxDistance, dist[v]);
+		}
+	}
+}
+
+// Graph building and traversals run on a worker; the UI only reads the graph
+// and results while no job is running.
+struct GraphJob {
+	std::thread worker;
+	std::atomic<bool> running{ false };
+	std::string status;
+	CsrGraph graph;
+	TraversalResult result;
+	int algorithm = 0; // 0: BFS, 1: Dijkstra
+	bool hasResult = false;
+
+	// Per-cell minimum visit time, so large graphs draw in O(cells) per frame
+	int cellsX = 0, cellsY = 0;
+	std::vector<int> cellTime;
+};
+GraphJob graphJob;
+
+void buildGraphCells(GraphJob& job) {
+	const CsrGraph& g = job.graph;
+	job.cellsX = std::min(g.layoutWidth, 160);
+	job.cellsY = std::min(g.layoutHeight, 120);
+	job.cellTime.assign((size_t)job.cellsX * job.cellsY, INT_MAX);
+	for (int v = 0; v < g.vertices; ++v) {
+		if (job.result.time[v] < 0) continue;
+		ImVec2 p = g.position(v);
+		int cx = std::min(job.cellsX - 1, (int)(p.x * job.cellsX));
+		int cy = std::min(job.cellsY - 1, (int)(p.y * job.cellsY));
+		int& cell = job.cellTime[(size_t)cy * job.cellsX + cx];
+		cell = std::min(cell, job.result.time[v]);
+	}
+}
+
+template <typename F>
+void startGraphJob(F work) {
+	if (graphJob.running) return;
+	if (graphJob.worker.joinable()) graphJob.worker.join();
+	graphJob.running = true;
+	graphJob.worker = std::thread([work]() {
+		AllocScope scope(TagGraph);
+		try {
+			work();
+		}
+		catch (const std::bad_alloc&) {
+			// A half-built graph or result can't be drawn; drop both
+			graphJob.graph = CsrGraph();
+			graphJob.result = TraversalResult();
+			graphJob.hasResult = false;
+			graphJob.status = "Out of memory; the graph was discarded.";
+		}
+		graphJob.running = false;
+		});
+}
+
+void stopGraphJob() {
+	if (graphJob.worker.joinable()) {
+		graphJob.worker.join();
+	}
+}
+
+const int forceLayoutLimit = 1000; // Largest graph given a force-directed layout
+
+void RenderGraph() {
+	static const char* generatorNames[] = { "Grid", "Random", "Edge List File" };
+	static const char* algorithmNames[] = { "BFS (direction-optimizing)", "Dijkstra (radix heap)" };
+	static int generator = 0;
+	static int gridWidth = 1000, gridHeight = 1000;
+	static int randomVertices = 1000000, averageDegree = 16;
+	static char graphPath[260] = "";
+	static bool undirectedFile = true;
+	static int source = 0;
+	static int algorithm = 0;
+	static int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+	static float animationSeconds = 5.0f;
+	static float animationTime = 0.0f;
+
+	ImGui::Begin("Graph");
+
+	bool idle = !graphJob.running;
+	ImGui::Combo("Generator", &generator, generatorNames, IM_ARRAYSIZE(generatorNames));
+	if (generator == 0) {
+		ImGui::InputInt("Width", &gridWidth, 10, 100);
+		ImGui::InputInt("Height", &gridHeight, 10, 100);
+	}
+	else if (generator == 1) {
+		ImGui::InputInt("Vertices", &randomVertices, 1000, 100000);
+		ImGui::InputInt("Average degree", &averageDegree, 1, 4);
+	}
+	else {
+		ImGui::InputText("Edge List", graphPath, sizeof(graphPath));
+		ImGui::Checkbox("Undirected", &undirectedFile);
+	}
+
+	if (idle && ImGui::Button("Build Graph")) {
+		int gen = generator, w = std::max(1, gridWidth), h = std::max(1, gridHeight);
+		int n = std::max(1, randomVertices), d = std::max(1, averageDegree);
+		std::string path = graphPath;
+		bool undirected = undirectedFile;
+		graphJob.hasResult = false;
+		startGraphJob([gen, w, h, n, d, path, undirected]() {
+			std::mt19937 rng(42);
+			std::string error;
+			auto start = std::chrono::high_resolution_clock::now();
+			CsrGraph& g = graphJob.graph;
+			if (gen == 0) generateGridGraph(g, w, h, rng);
+			else if (gen == 1) generateRandomGraph(g, n, d, rng);
+			else if (!loadGraphFile(g, path, undirected, error)) {
+				graphJob.status = error;
+				return;
+			}
+			if (gen != 0 && g.vertices <= forceLayoutLimit) forceDirectedLayout(g, 100, rng);
+			double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+			graphJob.status = "Built in " + std::to_string(seconds) + " s.";
+			});
+		idle = false; // The worker owns the graph from here on
+	}
+
+	const CsrGraph& g = graphJob.graph;
+	if (idle && g.vertices > 0) {
+		double csrBytes = (double)g.offsets.size() * sizeof(int64_t) + g.targets.size() * (sizeof(int) + sizeof(uint32_t));
+		char bytes[32];
+		ImGui::Text("%d vertices, %lld %s edges, CSR %s", g.vertices, (long long)(g.undirected ? g.edges() / 2 : g.edges()),
+			g.undirected ? "undirected" : "directed", formatBytes(bytes, sizeof(bytes), csrBytes));
+
+		ImGui::Combo("Algorithm", &algorithm, algorithmNames, IM_ARRAYSIZE(algorithmNames));
+		ImGui::InputInt("Source vertex", &source);
+		source = std::min(std::max(source, 0), g.vertices - 1);
+		if (!g.vertexIds.empty()) {
+			ImGui::SameLine();
+			ImGui::Text("(id %lld in the file)", g.vertexIds[source]);
+		}
+		if (algorithm == 0) ImGui::SliderInt("Threads", &threads, 1, 64);
+
+		if (ImGui::Button("Run")) {
+			int alg = algorithm, src = source, t = threads;
+			graphJob.hasResult = false;
+			startGraphJob([alg, src, t]() {
+				graphJob.algorithm = alg;
+				if (alg == 0) breadthFirstSearch(graphJob.graph, src, t, graphJob.result);
+				else dijkstra(graphJob.graph, src, graphJob.result);
+				buildGraphCells(graphJob);
+				graphJob.status.clear();
+				graphJob.hasResult = true;
+				});
+			idle = false;
+			animationTime = 0.0f;
+		}
+	}
+
+	if (!idle) {
+		ImGui::Text("Working...");
+	}
+	else if (!graphJob.status.empty()) {
+		ImGui::TextWrapped("%s", graphJob.status.c_str());
+	}
+
+	if (idle && graphJob.hasResult) {
+		const TraversalResult& r = graphJob.result;
+		ImGui::Text("%s: reached %d vertices in %.3f ms, %lld edges traversed, %.1f MTEPS",
+			algorithmNames[graphJob.algorithm], r.reached, r.seconds * 1e3, (long long)r.edgesTraversed,
+			r.seconds > 0.0 ? r.edgesTraversed / r.seconds / 1e6 : 0.0);
+		if (graphJob.algorithm == 0) ImGui::Text("%d levels, %d expanded bottom-up", r.totalSteps, r.bottomUpSteps);
+		else ImGui::Text("Farthest reached vertex at distance %u", r.maxDistance);
+
+		ImGui::SliderFloat("Animation (s)", &animationSeconds, 0.5f, 30.0f);
+		ImGui::SameLine();
+		if (ImGui::Button("Replay")) animationTime = 0.0f;
+	}
+
+	// Visualization
+	ImVec2 canvasPos = ImGui::GetCursorScreenPos();
+	ImVec2 canvasSize = ImGui::GetContentRegionAvail();
+	canvasSize.y = std::max(300.0f, canvasSize.y);
+	ImGui::InvisibleButton("Canvas", canvasSize);
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	drawList->AddRectFilled(canvasPos, ImVec2(canvasPos.x + canvasSize.x, canvasPos.y + canvasSize.y), IM_COL32(20, 20, 20, 255));
+
+	if (idle && graphJob.hasResult) {
+		const TraversalResult& r = graphJob.result;
+		animationTime = std::min(animationTime + ImGui::GetIO().DeltaTime, animationSeconds);
+		// BFS reveals one level at a time; Dijkstra reveals vertices in settle order
+		int threshold = (int)(r.maxTime * (animationTime / animationSeconds));
+		int frontierWindow = graphJob.algorithm == 0 ? 0 : std::max(1, r.maxTime / 100);
+
+		auto visitColor = [&](int time) {
+			if (time > threshold) return IM_COL32(60, 60, 60, 255);
+			if (time >= threshold - frontierWindow) return IM_COL32(255, 0, 0, 255); // Frontier
+			float t = r.maxTime > 0 ? (float)time / r.maxTime : 0.0f;
+			return IM_COL32((int)(t * 50), (int)(t * 255), (int)((1.0f - t) * 255), 255);
+		};
+
+		if (g.vertices <= forceLayoutLimit) {
+			// Small graphs: draw every edge and vertex
+			auto toCanvas = [&](int v) {
+				ImVec2 p = g.position(v);
+				return ImVec2(canvasPos.x + p.x * canvasSize.x, canvasPos.y + p.y * canvasSize.y);
+			};
+			for (int v = 0; v < g.vertices; ++v) {
+				for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+					if (g.undirected && g.targets[e] < v) continue;
+					drawList->AddLine(toCanvas(v), toCanvas(g.targets[e]), IM_COL32(90, 90, 90, 255));
+				}
+			}
+			float radius = std::max(2.0f, std::min(8.0f, canvasSize.x / (2.0f * g.layoutWidth)));
+			for (int v = 0; v < g.vertices; ++v) {
+				drawList->AddCircleFilled(toCanvas(v), radius, r.time[v] < 0 ? IM_COL32(40, 40, 40, 255) : visitColor(r.time[v]));
+			}
+		}
+		else {
+			// Large graphs: one cell per group of vertices, colored by its earliest visit
+			float cellWidth = canvasSize.x / graphJob.cellsX, cellHeight = canvasSize.y / graphJob.cellsY;
+			for (int cy = 0; cy < graphJob.cellsY; ++cy) {
+				for (int cx = 0; cx < graphJob.cellsX; ++cx) {
+					int time = graphJob.cellTime[(size_t)cy * graphJob.cellsX + cx];
+					if (time == INT_MAX) continue; // Nothing reached in this cell
+					ImVec2 p0(canvasPos.x + cx * cellWidth, canvasPos.y + cy * cellHeight);
+					drawList->AddRectFilled(p0, ImVec2(p0.x + cellWidth, p0.y + cellHeight), visitColor(time));
+				}
+			}
+		}
+	}
+
+	ImGui::End();
+}
+
+// Memory Panel
+
+// Live bytes, bytes per element, allocation counts and rate, and peak usage per
+// owner. Byte counts are the sizes requested from operator new; allocator
+// overhead isn't included.
+void RenderMemoryPanel(const LinkedList& list, const Stack& stack, const Queue& queue) {
+	static long long lastAllocations[AllocTagCount] = {};
+	static float allocationRate[AllocTagCount] = {};
+	static double lastSample = 0.0;
+	static double sampleTime = 0.0;
+
+	// Refresh allocation rates twice a second
+	sampleTime += ImGui::GetIO().DeltaTime;
+	if (sampleTime - lastSample >= 0.5) {
+		for (int tag = 0; tag < AllocTagCount; ++tag) {
+			long long allocations = allocStats[tag].allocations;
+			allocationRate[tag] = (float)((allocations - lastAllocations[tag]) / (sampleTime - lastSample));
+			lastAllocations[tag] = allocations;
+		}
+		lastSample = sampleTime;
+	}
+
+	// Element counts for the owners that hold elements
+	long long elements[AllocTagCount] = {};
+	elements[TagLinkedList] = (long long)list.count;
+	elements[TagStack] = (long long)stack.GetData().size();
+	elements[TagQueue] = (long long)queue.size();
+	if (ingestJob.running) {
+		std::lock_guard<std::mutex> lock(ingestJob.mutex);
+		elements[TagQueue] = (long long)ingestJob.queue.size();
+	}
+	withSortData(elementType, [&](const auto& values) { elements[TagSortData] = (long long)values.size(); });
+	// A running script holds structures of its own under the same tags
+	if (batchScriptRunning()) elements[TagLinkedList] = elements[TagStack] = elements[TagQueue] = 0;
+
+	ImGui::Begin("Memory");
+
+	char live[32], perElement[32], peak[32];
+	long long totalLive = 0;
+	if (ImGui::BeginTable("Allocations", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Owner");
+		ImGui::TableSetupColumn("Live");
+		ImGui::TableSetupColumn("Bytes/Element");
+		ImGui::TableSetupColumn("Allocations");
+		ImGui::TableSetupColumn("Frees");
+		ImGui::TableSetupColumn("Allocs/s");
+		ImGui::TableSetupColumn("Peak");
+		ImGui::TableHeadersRow();
+		for (int tag = 0; tag < AllocTagCount; ++tag) {
+			const AllocStats& stats = allocStats[tag];
+			long long liveBytes = stats.liveBytes;
+			totalLive += liveBytes;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", allocTagNames[tag]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", formatBytes(live, sizeof(live), (double)liveBytes));
+			ImGui::TableNextColumn();
+			if (elements[tag] > 0) ImGui::Text("%.1f", (double)liveBytes / elements[tag]);
+			else ImGui::Text("-");
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", (long long)stats.allocations);
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", (long long)stats.frees);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", allocationRate[tag]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", formatBytes(peak, sizeof(peak), (double)stats.peakBytes));
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::Text("Total live: %s", formatBytes(live, sizeof(live), (double)totalLive));
+	ImGui::Text("Peak during last sort: %s (scratch), external sort: %s",
+		formatBytes(peak, sizeof(peak), (double)allocStats[TagSorting].peakBytes),
+		formatBytes(perElement, sizeof(perElement), (double)allocStats[TagExternalSort].peakBytes));
+
+	ImGui::End();
+}
+
+// Main Application
+int main(int argc, char** argv) {
+	// Headless capture mode (see RunCapture)
+	CaptureOptions captureOptions;
+	if (parseCaptureArgs(argc, argv, captureOptions)) {
+		return RunCapture(captureOptions);
+	}
+
+	// Initialize GLFW and OpenGL
+	if (!glfwInit()) return -1;
+	const char* glsl_version = "#version 130";
+	GLFWwindow* window = glfwCreateWindow(1280, 720, "Cenceptualization of DS", NULL, NULL);
+	if (!window) return -1;
+	glfwMakeContextCurrent(window);
+	glfwSwapInterval(1);
+
+	// Initialize ImGui
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGui_ImplGlfw_InitForOpenGL(window, true);
+	ImGui_ImplOpenGL3_Init(glsl_version);
+	ApplyAppStyle();
 
 	// State Variables
-	int selectedUI = 0;  // 0: Linked List, 1: Sorting, 2: Stack, 3: Queue
+	int selectedUI = 0;  // 0: Linked List, 1: Sorting, 2: Stack, 3: Queue, 4: Batch Script, 5: Graph
 	LinkedList list;
 	Stack stack;
 	Queue queue;
+	size_t viewAllocations = 0; // Heap allocations made by the selected view last frame
+	bool showMemoryPanel = false;
 	generateRandomData(50);
 
 	// Main loop
@@ -818,19 +4416,31 @@ int main() {
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
 
+		// Pick up the structures built by a finished batch script
+		collectBatchScript(list, stack, queue);
+
 		// Navigation Window
 		ImGui::Begin("Main Menu");
 		if (ImGui::Button("Linked List")) selectedUI = 0;
 		if (ImGui::Button("Sorting")) selectedUI = 1;
 		if (ImGui::Button("Stack")) selectedUI = 2;
 		if (ImGui::Button("Queue")) selectedUI = 3;
+		if (ImGui::Button("Batch Script")) selectedUI = 4;
+		if (ImGui::Button("Graph")) selectedUI = 5;
+		ImGui::Text("Heap allocations last frame: %zu", viewAllocations);
+		ImGui::Checkbox("Memory Panel", &showMemoryPanel);
 		ImGui::End();
 
-		// Render Selected UI
+		// Render Selected UI, counting the heap allocations it makes
+		size_t allocationsBefore = threadAllocationCount;
 		if (selectedUI == 0) RenderLinkedList(list);
 		else if (selectedUI == 1) RenderSorting();
 		else if (selectedUI == 2) RenderStackUI(stack);
 		else if (selectedUI == 3) RenderQueue(queue);
+		else if (selectedUI == 4) RenderBatchScript(list, stack, queue);
+		else if (selectedUI == 5) RenderGraph();
+		viewAllocations = threadAllocationCount - allocationsBefore;
+		if (showMemoryPanel) RenderMemoryPanel(list, stack, queue);
 
 		// Render Background window
 		ImGui::Render();
@@ -844,6 +4454,17 @@ int main() {
 	}
 
 	// Cleanup
+	stopIngest(queue);
+	stopBatchScript();
+	collectBatchScript(list, stack, queue);
+	if (sortBenchmark.worker.joinable()) {
+		sortBenchmark.worker.detach(); // Unobserved sorts can't be cancelled
+	}
+	stopExternalSort();
+	stopGraphJob();
+	if (listSortBenchmark.worker.joinable()) {
+		listSortBenchmark.worker.join();
+	}
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
 	ImGui::DestroyContext();